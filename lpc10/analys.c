@@ -4,31 +4,25 @@
 */
 
 #include "f2c.h"
+#include "lpcprof.h"
 
 int analys_(real* speech, integer* voice, integer* pitch, real* rms, real* rc, struct lpc10_encoder_state* st);
 
-/* Common Block Declarations */
-
-extern struct {
-    integer order, lframe;
-    logical corrp;
-} contrl_;
-
-#define contrl_1 contrl_
-
 /* Table of constant values */
 
-static integer c__10 = 10;
-static integer c__181 = 181;
-static integer c__720 = 720;
-static integer c__3 = 3;
-static integer c__90 = 90;
-static integer c__156 = 156;
-static integer c__307 = 307;
-static integer c__462 = 462;
-static integer c__312 = 312;
-static integer c__60 = 60;
-static integer c__1 = 1;
+static const integer c__10 = 10;
+static const integer c__181 = 181;
+static const integer c__720 = 720;
+static const integer c__3 = 3;
+static const integer c__90 = 90;
+static const integer c__156 = 156;
+static const integer c__307 = 307;
+static const integer c__462 = 462;
+static const integer c__312 = 312;
+static const integer c__60 = 60;
+static const integer c__1 = 1;
+static const integer c_order = LPC10_ORDER;
+static const integer c_lframe = LPC10_LFRAME;
 
 /* ****************************************************************** */
 
@@ -124,11 +118,12 @@ static integer c__1 = 1;
 /* Subroutine */ int analys_(real* speech, integer* voice, integer* pitch, real* rms, real* rc, struct lpc10_encoder_state* st) {
     /* Initialized data */
 
-    static integer tau[60] = {20, 21, 22, 23, 24, 25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,
-                              40, 42, 44, 46, 48, 50,  52,  54,  56,  58,  60,  62,  64,  66,  68,  70,  72,  74,  76,  78,
-                              80, 84, 88, 92, 96, 100, 104, 108, 112, 116, 120, 124, 128, 132, 136, 140, 144, 148, 152, 156};
-    static integer buflim[4] = {181, 720, 25, 720};
-    static real precoef = .9375f;
+    static const integer tau[60] = {20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,  34,
+                                    35,  36,  37,  38,  39,  40,  42,  44,  46,  48,  50,  52,  54,  56,  58,
+                                    60,  62,  64,  66,  68,  70,  72,  74,  76,  78,  80,  84,  88,  92,  96,
+                                    100, 104, 108, 112, 116, 120, 124, 128, 132, 136, 140, 144, 148, 152, 156};
+    static const integer buflim[4] = {181, 720, 25, 720};
+    static const real precoef = .9375f;
 
     /* System generated locals */
     integer i__1;
@@ -138,37 +133,43 @@ static integer c__1 = 1;
     integer half;
     real abuf[156];
     real* bias;
-    extern /* Subroutine */ int tbdm_(real*, integer*, integer*, integer*, real*, integer*, integer*, integer*);
+    extern /* Subroutine */ int tbdm_(real*, const integer*, const integer*, const integer*, real*, integer*, integer*, integer*);
     integer* awin;
     integer midx, ewin[6] /* was [2][3] */;
     real ivrc[2], temp;
     real* zpre;
     integer* vwin;
-    integer i__, j, lanal;
-    extern /* Subroutine */ int rcchk_(integer*, real*, real*), mload_(integer*, integer*, integer*, real*, real*, real*);
+    integer i__, j, k, lanal;
+    extern /* Subroutine */ int rcchk_(const integer*, real*, real*),
+        mload_(const integer*, const integer*, integer*, real*, real*, real*);
     real *inbuf, *pebuf;
     real *lpbuf, *ivbuf;
     real* rcbuf;
     integer* osbuf;
-    extern /* Subroutine */ int onset_(real*, integer*, integer*, integer*, integer*, integer*, integer*,
+    extern /* Subroutine */ int onset_(real*, integer*, integer*, const integer*, const integer*, const integer*, const integer*,
                                        struct lpc10_encoder_state*);
     integer* osptr;
-    extern int placea_(integer*, integer*, integer*, integer*, integer*, integer*, integer*, integer*, integer*),
+    extern int placea_(integer*, integer*, integer*, const integer*, integer*, integer*, integer*, const integer*,
+                       const integer*),
         dcbias_(integer*, real*, real*),
-        placev_(integer*, integer*, integer*, integer*, integer*, integer*, integer*, integer*, integer*, integer*, integer*);
+        placev_(integer*, integer*, const integer*, integer*, integer*, const integer*, const integer*, const integer*,
+                const integer*, const integer*, const integer*);
     integer ipitch;
     integer* obound;
-    extern /* Subroutine */ int preemp_(real*, real*, integer*, real*, real*),
-        voicin_(integer*, real*, real*, integer*, integer*, real*, real*, integer*, real*, integer*, integer*, integer*,
-                struct lpc10_encoder_state*);
+    extern /* Subroutine */ int preemp_(real*, real*, const integer*, const real*, real*),
+        voicin_(integer*, real*, real*, const integer*, integer*, real*, real*, integer*, real*, integer*, integer*,
+                const integer*, struct lpc10_encoder_state*);
     integer* voibuf;
     integer mintau;
     real* rmsbuf;
-    extern /* Subroutine */ int lpfilt_(real*, real*, integer*, integer*), ivfilt_(real*, real*, integer*, integer*, real*),
-        energy_(integer*, real*, real*), invert_(integer*, real*, real*, real*);
+    extern /* Subroutine */ int lpfilt_(real*, real*, const integer*, const integer*),
+        ivfilt_(real*, real*, const integer*, const integer*, real*), energy_(integer*, real*, real*),
+        invert_(const integer*, real*, real*, real*);
     integer minptr, maxptr;
-    extern /* Subroutine */ int dyptrk_(real*, integer*, integer*, integer*, integer*, integer*, struct lpc10_encoder_state*);
+    extern /* Subroutine */ int dyptrk_(real*, const integer*, integer*, integer*, integer*, integer*,
+                                        struct lpc10_encoder_state*);
     real phi[100] /* was [10][10] */, psi[10];
+    LPC10_PROF_DECL
 
     /*   LPC Processing control variables: */
 
@@ -297,8 +298,8 @@ static integer c__1 = 1;
     /* Function Body */
 
     /*   Calculations are done on future frame due to requirements */
-    /*   of the pitch tracker.  Delay RMS and RC's 2 frames to give */
-    /*   current frame parameters on return. */
+    /*   of the pitch tracker.  Delay RMS and RC's 2 frames (1 frame in */
+    /*   low-delay mode) to give current frame parameters on return. */
     /*   Update all buffers */
 
     inbuf = &(st->inbuf[0]);
@@ -316,24 +317,24 @@ static integer c__1 = 1;
     rcbuf = &(st->rcbuf[0]);
     zpre = &(st->zpre);
 
-    i__1 = 720 - contrl_1.lframe;
+    i__1 = 720 - LPC10_LFRAME;
     for (i__ = 181; i__ <= i__1; ++i__) {
-        inbuf[i__ - 181] = inbuf[contrl_1.lframe + i__ - 181];
-        pebuf[i__ - 181] = pebuf[contrl_1.lframe + i__ - 181];
+        inbuf[i__ - 181] = inbuf[LPC10_LFRAME + i__ - 181];
+        pebuf[i__ - 181] = pebuf[LPC10_LFRAME + i__ - 181];
     }
-    i__1 = 540 - contrl_1.lframe;
+    i__1 = 540 - LPC10_LFRAME;
     for (i__ = 229; i__ <= i__1; ++i__) {
-        ivbuf[i__ - 229] = ivbuf[contrl_1.lframe + i__ - 229];
+        ivbuf[i__ - 229] = ivbuf[LPC10_LFRAME + i__ - 229];
     }
-    i__1 = 720 - contrl_1.lframe;
+    i__1 = 720 - LPC10_LFRAME;
     for (i__ = 25; i__ <= i__1; ++i__) {
-        lpbuf[i__ - 25] = lpbuf[contrl_1.lframe + i__ - 25];
+        lpbuf[i__ - 25] = lpbuf[LPC10_LFRAME + i__ - 25];
     }
     j = 1;
     i__1 = (*osptr) - 1;
     for (i__ = 1; i__ <= i__1; ++i__) {
-        if (osbuf[i__ - 1] > contrl_1.lframe) {
-            osbuf[j - 1] = osbuf[i__ - 1] - contrl_1.lframe;
+        if (osbuf[i__ - 1] > LPC10_LFRAME) {
+            osbuf[j - 1] = osbuf[i__ - 1] - LPC10_LFRAME;
             ++j;
         }
     }
@@ -341,10 +342,10 @@ static integer c__1 = 1;
     voibuf[0] = voibuf[2];
     voibuf[1] = voibuf[3];
     for (i__ = 1; i__ <= 2; ++i__) {
-        vwin[(i__ << 1) - 2] = vwin[((i__ + 1) << 1) - 2] - contrl_1.lframe;
-        vwin[(i__ << 1) - 1] = vwin[((i__ + 1) << 1) - 1] - contrl_1.lframe;
-        awin[(i__ << 1) - 2] = awin[((i__ + 1) << 1) - 2] - contrl_1.lframe;
-        awin[(i__ << 1) - 1] = awin[((i__ + 1) << 1) - 1] - contrl_1.lframe;
+        vwin[(i__ << 1) - 2] = vwin[((i__ + 1) << 1) - 2] - LPC10_LFRAME;
+        vwin[(i__ << 1) - 1] = vwin[((i__ + 1) << 1) - 1] - LPC10_LFRAME;
+        awin[(i__ << 1) - 2] = awin[((i__ + 1) << 1) - 2] - LPC10_LFRAME;
+        awin[(i__ << 1) - 1] = awin[((i__ + 1) << 1) - 1] - LPC10_LFRAME;
         /*       EWIN(*,J) is unused for J .NE. AF, so the following shift is
          */
         /*       unnecessary.  It also causes error messages when the C versio
@@ -359,7 +360,7 @@ static integer c__1 = 1;
         voibuf[i__ * 2] = voibuf[(i__ + 1) * 2];
         voibuf[(i__ << 1) + 1] = voibuf[((i__ + 1) << 1) + 1];
         rmsbuf[i__ - 1] = rmsbuf[i__];
-        i__1 = contrl_1.order;
+        i__1 = LPC10_ORDER;
         for (j = 1; j <= i__1; ++j) {
             rcbuf[j + i__ * 10 - 11] = rcbuf[j + (i__ + 1) * 10 - 11];
         }
@@ -374,27 +375,29 @@ static integer c__1 = 1;
      */
     /*       cases, keep BIAS the same. */
     temp = 0.f;
-    i__1 = contrl_1.lframe;
+    i__1 = LPC10_LFRAME;
     for (i__ = 1; i__ <= i__1; ++i__) {
-        inbuf[720 - contrl_1.lframe + i__ - 181] = speech[i__] * 4096.f - (*bias);
-        temp += inbuf[720 - contrl_1.lframe + i__ - 181];
+        inbuf[720 - LPC10_LFRAME + i__ - 181] = speech[i__] * 4096.f - (*bias);
+        temp += inbuf[720 - LPC10_LFRAME + i__ - 181];
     }
-    if (temp > (real)contrl_1.lframe) {
+    if (temp > (real)LPC10_LFRAME) {
         *bias += 1;
     }
-    if (temp < (real)(-contrl_1.lframe)) {
+    if (temp < (real)(-LPC10_LFRAME)) {
         *bias += -1;
     }
     /*   Place Voicing Window */
-    i__ = 721 - contrl_1.lframe;
-    preemp_(&inbuf[i__ - 181], &pebuf[i__ - 181], &contrl_1.lframe, &precoef, zpre);
-    onset_(pebuf, osbuf, osptr, &c__10, &c__181, &c__720, &contrl_1.lframe, st);
+    i__ = 721 - LPC10_LFRAME;
+    preemp_(&inbuf[i__ - 181], &pebuf[i__ - 181], &c_lframe, &precoef, zpre);
+    onset_(pebuf, osbuf, osptr, &c__10, &c__181, &c__720, &c_lframe, st);
 
     /*       MAXOSP is just a debugging variable. */
 
     /* 	MAXOSP = MAX( MAXOSP, OSPTR ) */
 
-    placev_(osbuf, osptr, &c__10, &obound[2], vwin, &c__3, &contrl_1.lframe, &c__90, &c__156, &c__307, &c__462);
+    LPC10_PROF_START();
+    placev_(osbuf, osptr, &c__10, &obound[2], vwin, &c__3, &c_lframe, &c__90, &c__156, &c__307, &c__462);
+    LPC10_PROF_STOP(st, LPC10_PROF_PLACE);
     /*        The Pitch Extraction algorithm estimates the pitch for a frame
      */
     /*   of speech by locating the minimum of the average magnitude difference
@@ -414,17 +417,23 @@ static integer c__1 = 1;
     /*       of INBUF, and writes indices LBUFH+1-LFRAME = 541 through LBUFH
      */
     /*       = 720 of LPBUF. */
-    lpfilt_(&inbuf[228], &lpbuf[384], &c__312, &contrl_1.lframe);
+    LPC10_PROF_START();
+    lpfilt_(&inbuf[228], &lpbuf[384], &c__312, &c_lframe);
+    LPC10_PROF_STOP(st, LPC10_PROF_LPFILT);
     /*       IVFILT reads indices (PWINH-LFRAME-7) = 353 through PWINH = 540
      */
     /*       of LPBUF, and writes indices (PWINH-LFRAME+1) = 361 through */
     /*       PWINH = 540 of IVBUF. */
-    ivfilt_(&lpbuf[204], ivbuf, &c__312, &contrl_1.lframe, ivrc);
+    LPC10_PROF_START();
+    ivfilt_(&lpbuf[204], ivbuf, &c__312, &c_lframe, ivrc);
+    LPC10_PROF_STOP(st, LPC10_PROF_IVFILT);
     /*       TBDM reads indices PWINL = 229 through */
     /*       (PWINL-1)+MAXWIN+(TAU(LTAU)-TAU(1))/2 = 452 of IVBUF, and writes
      */
     /*       indices 1 through LTAU = 60 of AMDF. */
+    LPC10_PROF_START();
     tbdm_(ivbuf, &c__156, tau, &c__60, amdf, &minptr, &maxptr, &mintau);
+    LPC10_PROF_STOP(st, LPC10_PROF_TBDM);
     /*        Voicing decisions are made for each half frame of input speech.
      */
     /*   An initial voicing classification is made for each half of the */
@@ -440,16 +449,22 @@ static integer c__1 = 1;
     /*   introduce two frames of delay into the corrected pitch estimates and
      */
     /*   voicing decisions. */
+    LPC10_PROF_START();
     for (half = 1; half <= 2; ++half) {
         voicin_(&vwin[4], inbuf, lpbuf, buflim, &half, &amdf[minptr - 1], &amdf[maxptr - 1], &mintau, ivrc, obound, voibuf, &c__3,
                 st);
     }
+    LPC10_PROF_STOP(st, LPC10_PROF_VOICIN);
     /*   Find the minimum cost pitch decision over several frames */
     /*   given the current voicing decision and the AMDF array */
+    LPC10_PROF_START();
     dyptrk_(amdf, &c__60, &minptr, &voibuf[7], pitch, &midx, st);
+    LPC10_PROF_STOP(st, LPC10_PROF_DYPTRK);
     ipitch = tau[midx - 1];
     /*   Place spectrum analysis and energy windows */
-    placea_(&ipitch, voibuf, &obound[2], &c__3, vwin, awin, ewin, &contrl_1.lframe, &c__156);
+    LPC10_PROF_START();
+    placea_(&ipitch, voibuf, &obound[2], &c__3, vwin, awin, ewin, &c_lframe, &c__156);
+    LPC10_PROF_STOP(st, LPC10_PROF_PLACE);
     /*  Remove short term DC bias over the analysis window, Put result in ABUF
      */
     lanal = awin[5] + 1 - awin[4];
@@ -463,16 +478,24 @@ static integer c__1 = 1;
     i__1 = ewin[5] - ewin[4] + 1;
     energy_(&i__1, &abuf[ewin[4] - awin[4]], &rmsbuf[2]);
     /*   Matrix load and invert, check RC's for stability */
-    mload_(&contrl_1.order, &c__1, &lanal, abuf, phi, psi);
-    invert_(&contrl_1.order, phi, psi, &rcbuf[20]);
-    rcchk_(&contrl_1.order, &rcbuf[10], &rcbuf[20]);
-    /*   Set return parameters */
-    voice[1] = voibuf[2];
-    voice[2] = voibuf[3];
-    *rms = rmsbuf[0];
-    i__1 = contrl_1.order;
+    LPC10_PROF_START();
+    mload_(&c_order, &c__1, &lanal, abuf, phi, psi);
+    LPC10_PROF_STOP(st, LPC10_PROF_MLOAD);
+    LPC10_PROF_START();
+    invert_(&c_order, phi, psi, &rcbuf[20]);
+    LPC10_PROF_STOP(st, LPC10_PROF_INVERT);
+    rcchk_(&c_order, &rcbuf[10], &rcbuf[20]);
+    /*   Set return parameters, for the frame two frames before the */
+    /*   analysis frame, or in low-delay mode for the frame just before it. */
+    /*   Its voicing has then only been smoothed with one frame of */
+    /*   look-ahead, and DYPTRK traces its pitch back one frame. */
+    k = st->lowdelay ? 1 : 0;
+    voice[1] = voibuf[(k << 1) + 2];
+    voice[2] = voibuf[(k << 1) + 3];
+    *rms = rmsbuf[k];
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
-        rc[i__] = rcbuf[i__ - 1];
+        rc[i__] = rcbuf[i__ + k * 10 - 1];
     }
     return 0;
 } /* analys_ */
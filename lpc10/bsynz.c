@@ -28,15 +28,6 @@ int bsynz_(real* coef,
            real* g2pass,
            struct lpc10_decoder_state* st);
 
-/* Common Block Declarations */
-
-extern struct {
-    integer order, lframe;
-    logical corrp;
-} contrl_;
-
-#define contrl_1 contrl_
-
 /* ***************************************************************** */
 
 /* 	BSYNZ Version 54 */
@@ -100,8 +91,8 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
 
     integer* ipo;
     real* rmso;
-    static integer kexc[25] = {8,    -16, 26,  -48, 86,  -162, 294, -502, 718, -728, 184, 672, -610,
-                               -672, 184, 728, 718, 502, 294,  162, 86,   48,  26,   16,  8};
+    static const integer kexc[25] = {8,    -16, 26,  -48, 86,  -162, 294, -502, 718, -728, 184, 672, -610,
+                                     -672, 184, 728, 718, 502, 294,  162, 86,   48,  26,   16,  8};
     real* exc;
     real* exc2;
     real* lpi1;
@@ -244,7 +235,7 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
     r__1 = *rmso / (*rms + 1e-6f);
     xy = min(r__1, 8.f);
     *rmso = *rms;
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
         exc2[i__ - 1] = exc2[*ipo + i__ - 1] * xy;
     }
@@ -253,7 +244,7 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
         /*  Generate white noise for unvoiced */
         i__1 = *ip;
         for (i__ = 1; i__ <= i__1; ++i__) {
-            exc[contrl_1.order + i__ - 1] = (real)(random_(st) / 64);
+            exc[LPC10_ORDER + i__ - 1] = (real)(random_(st) / 64);
         }
         /*  Impulse doublet excitation for plosives */
         /*       (RANDOM()+32768) is in the range 0 to 2**16-1.  Therefore the
@@ -263,7 +254,7 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
         /*       least 32 bits (16 isn't enough), and PX should be in the rang
         e */
         /*       ORDER+1+0 through ORDER+1+(IP-2) .EQ. ORDER+IP-1. */
-        px = (random_(st) + 32768) * (*ip - 1) / 65536 + contrl_1.order + 1;
+        px = (random_(st) + 32768) * (*ip - 1) / 65536 + LPC10_ORDER + 1;
         r__1 = *ratio / 4 * 1.f;
         pulse = r__1 * 342;
         if (pulse > 2e3f) {
@@ -276,32 +267,32 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
         sscale = sqrt((real)(*ip)) / 6.928f;
         i__1 = *ip;
         for (i__ = 1; i__ <= i__1; ++i__) {
-            exc[contrl_1.order + i__ - 1] = 0.f;
+            exc[LPC10_ORDER + i__ - 1] = 0.f;
             if (i__ <= 25) {
-                exc[contrl_1.order + i__ - 1] = sscale * kexc[i__ - 1];
+                exc[LPC10_ORDER + i__ - 1] = sscale * kexc[i__ - 1];
             }
-            lpi0 = exc[contrl_1.order + i__ - 1];
-            r__2 = exc[contrl_1.order + i__ - 1] * .125f + *lpi1 * .75f;
+            lpi0 = exc[LPC10_ORDER + i__ - 1];
+            r__2 = exc[LPC10_ORDER + i__ - 1] * .125f + *lpi1 * .75f;
             r__1 = r__2 + *lpi2 * .125f;
-            exc[contrl_1.order + i__ - 1] = r__1 + *lpi3 * 0.f;
+            exc[LPC10_ORDER + i__ - 1] = r__1 + *lpi3 * 0.f;
             *lpi3 = *lpi2;
             *lpi2 = *lpi1;
             *lpi1 = lpi0;
         }
         i__1 = *ip;
         for (i__ = 1; i__ <= i__1; ++i__) {
-            noise[contrl_1.order + i__ - 1] = random_(st) * 1.f / 64;
-            hpi0 = noise[contrl_1.order + i__ - 1];
-            r__2 = noise[contrl_1.order + i__ - 1] * -.125f + *hpi1 * .25f;
+            noise[LPC10_ORDER + i__ - 1] = random_(st) * 1.f / 64;
+            hpi0 = noise[LPC10_ORDER + i__ - 1];
+            r__2 = noise[LPC10_ORDER + i__ - 1] * -.125f + *hpi1 * .25f;
             r__1 = r__2 + *hpi2 * -.125f;
-            noise[contrl_1.order + i__ - 1] = r__1 + *hpi3 * 0.f;
+            noise[LPC10_ORDER + i__ - 1] = r__1 + *hpi3 * 0.f;
             *hpi3 = *hpi2;
             *hpi2 = *hpi1;
             *hpi1 = hpi0;
         }
         i__1 = *ip;
         for (i__ = 1; i__ <= i__1; ++i__) {
-            exc[contrl_1.order + i__ - 1] += noise[contrl_1.order + i__ - 1];
+            exc[LPC10_ORDER + i__ - 1] += noise[LPC10_ORDER + i__ - 1];
         }
     }
     /*   Synthesis filters: */
@@ -309,9 +300,9 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
     xssq = 0.f;
     i__1 = *ip;
     for (i__ = 1; i__ <= i__1; ++i__) {
-        k = contrl_1.order + i__;
+        k = LPC10_ORDER + i__;
         sum = 0.f;
-        i__2 = contrl_1.order;
+        i__2 = LPC10_ORDER;
         for (j = 1; j <= i__2; ++j) {
             sum += coef[j] * exc[k - j - 1];
         }
@@ -321,9 +312,9 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
     /*   Synthesize using the all pole filter  1 / (1 - SUM) */
     i__1 = *ip;
     for (i__ = 1; i__ <= i__1; ++i__) {
-        k = contrl_1.order + i__;
+        k = LPC10_ORDER + i__;
         sum = 0.f;
-        i__2 = contrl_1.order;
+        i__2 = LPC10_ORDER;
         for (j = 1; j <= i__2; ++j) {
             sum += coef[j] * exc2[k - j - 1];
         }
@@ -331,7 +322,7 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
         xssq += exc2[k - 1] * exc2[k - 1];
     }
     /*  Save filter history for next epoch */
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
         exc[i__ - 1] = exc[*ip + i__ - 1];
         exc2[i__ - 1] = exc2[*ip + i__ - 1];
@@ -342,7 +333,7 @@ bsynz_(real* coef, integer* ip, integer* iv, real* sout, real* rms, real* ratio,
     gain = sqrt(ssq / xssq);
     i__1 = *ip;
     for (i__ = 1; i__ <= i__1; ++i__) {
-        sout[i__] = gain * exc2[contrl_1.order + i__ - 1];
+        sout[i__] = gain * exc2[LPC10_ORDER + i__ - 1];
     }
     return 0;
 } /* bsynz_ */
@@ -18,8 +18,8 @@
 
 #include "f2c.h"
 
-int chanwr_(integer* order, integer* ipitv, integer* irms, integer* irc, integer* ibits, struct lpc10_encoder_state* st);
-int chanrd_(integer* order, integer* ipitv, integer* irms, integer* irc, integer* ibits);
+int chanwr_(const integer* order, integer* ipitv, integer* irms, integer* irc, integer* ibits, struct lpc10_encoder_state* st);
+int chanrd_(const integer* order, integer* ipitv, integer* irms, integer* irc, integer* ibits);
 
 /* *********************************************************************** */
 
@@ -103,14 +103,20 @@ int chanrd_(integer* order, integer* ipitv, integer* irms, integer* irc, integer
 /* 	R5-2, R6-2,R10-1, R8-2,  P-6, R9-1, */
 /* 	R5-3, R6-3, R7-3, R9-2, R8-3, SYNC */
 static int
-chanwr_0_(int n__, integer* order, integer* ipitv, integer* irms, integer* irc, integer* ibits, struct lpc10_encoder_state* st) {
+chanwr_0_(int n__,
+          const integer* order,
+          integer* ipitv,
+          integer* irms,
+          integer* irc,
+          integer* ibits,
+          struct lpc10_encoder_state* st) {
     /* Initialized data */
 
     integer* isync;
-    static integer bit[10] = {2, 4, 8, 8, 8, 8, 16, 16, 16, 16};
-    static integer iblist[53] = {13, 12, 11, 1,  2,  13, 12, 11, 1, 2,  13, 10, 11, 2,  1, 10, 13, 12,
-                                 11, 10, 2,  13, 12, 11, 10, 2,  1, 12, 7,  6,  1,  10, 9, 8,  7,  4,
-                                 6,  9,  8,  7,  5,  1,  9,  8,  4, 6,  1,  5,  9,  8,  7, 5,  6};
+    static const integer bit[10] = {2, 4, 8, 8, 8, 8, 16, 16, 16, 16};
+    static const integer iblist[53] = {13, 12, 11, 1,  2,  13, 12, 11, 1, 2,  13, 10, 11, 2,  1, 10, 13, 12,
+                                       11, 10, 2,  13, 12, 11, 10, 2,  1, 12, 7,  6,  1,  10, 9, 8,  7,  4,
+                                       6,  9,  8,  7,  5,  1,  9,  8,  4, 6,  1,  5,  9,  8,  7, 5,  6};
 
     /* System generated locals */
     integer i__1;
@@ -191,7 +197,7 @@ L_chanrd:
     return 0;
 } /* chanwr_ */
 
-/* Subroutine */ int chanwr_(integer* order,
+/* Subroutine */ int chanwr_(const integer* order,
                              integer* ipitv,
                              integer* irms,
                              integer* irc,
@@ -200,6 +206,6 @@ L_chanrd:
     return chanwr_0_(0, order, ipitv, irms, irc, ibits, st);
 }
 
-/* Subroutine */ int chanrd_(integer* order, integer* ipitv, integer* irms, integer* irc, integer* ibits) {
+/* Subroutine */ int chanrd_(const integer* order, integer* ipitv, integer* irms, integer* irc, integer* ibits) {
     return chanwr_0_(1, order, ipitv, irms, irc, ibits, 0);
 }
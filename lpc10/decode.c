@@ -33,7 +33,6 @@ extern int decode_(integer* ipitv,
 /* Common Block Declarations */
 
 extern struct {
-    integer order, lframe;
     logical corrp;
 } contrl_;
 
@@ -41,7 +40,8 @@ extern struct {
 
 /* Table of constant values */
 
-static integer c__2 = 2;
+static const integer c__2 = 2;
+static const integer c__5 = 5;
 
 /* ***************************************************************** */
 
@@ -125,35 +125,35 @@ static integer c__2 = 2;
     /* Initialized data */
 
     logical* first;
-    static integer ethrs = 2048;
-    static integer ethrs1 = 128;
-    static integer ethrs2 = 1024;
-    static integer ethrs3 = 2048;
-    static integer ivtab[32] = {24960, 24960, 24960, 24960, 25480, 25480, 25483, 25480, 16640, 1560,  1560,
-                                1560,  16640, 1816,  1563,  1560,  24960, 24960, 24859, 24856, 26001, 25881,
-                                25915, 25913, 1560,  1560,  7800,  3640,  1561,  1561,  3643,  3641};
-    static real corth[32] /* was [4][8] */ = {32767.f, 10.f, 5.f,  0.f,  32767.f, 8.f,  4.f,   0.f,  32.f, 6.4f, 3.2f,
-                                              0.f,     32.f, 6.4f, 3.2f, 0.f,     32.f, 11.2f, 6.4f, 0.f,  32.f, 11.2f,
-                                              6.4f,    0.f,  16.f, 5.6f, 3.2f,    0.f,  16.f,  5.6f, 3.2f, 0.f};
-    static integer detau[128] = {
+    static const integer ethrs = 2048;
+    static const integer ethrs1 = 128;
+    static const integer ethrs2 = 1024;
+    static const integer ethrs3 = 2048;
+    static const integer ivtab[32] = {24960, 24960, 24960, 24960, 25480, 25480, 25483, 25480, 16640, 1560,  1560,
+                                      1560,  16640, 1816,  1563,  1560,  24960, 24960, 24859, 24856, 26001, 25881,
+                                      25915, 25913, 1560,  1560,  7800,  3640,  1561,  1561,  3643,  3641};
+    static const real corth[32] /* was [4][8] */ = {32767.f, 10.f, 5.f,  0.f,  32767.f, 8.f,  4.f,   0.f,  32.f, 6.4f, 3.2f,
+                                                    0.f,     32.f, 6.4f, 3.2f, 0.f,     32.f, 11.2f, 6.4f, 0.f,  32.f, 11.2f,
+                                                    6.4f,    0.f,  16.f, 5.6f, 3.2f,    0.f,  16.f,  5.6f, 3.2f, 0.f};
+    static const integer detau[128] = {
         0,   0,  0,   3,  0,   3,  3,  31, 0,   3,   3,   21, 3,  3,  29, 30,  0,  3,  3,   20,  3,   25,  27,  26,  3,   23,
         58,  22, 3,   24, 28,  3,  0,  3,  3,   3,   3,   39, 33, 32, 3,  37,  35, 36, 3,   38,  34,  3,   3,   42,  46,  44,
         50,  40, 48,  3,  54,  3,  56, 3,  52,  3,   3,   1,  0,  3,  3,  108, 3,  78, 100, 104, 3,   84,  92,  88,  156, 80,
         96,  3,  3,   74, 70,  72, 66, 76, 68,  3,   62,  3,  60, 3,  64, 3,   3,  1,  3,   116, 132, 112, 148, 152, 3,   3,
         140, 3,  136, 3,  144, 3,  3,  1,  124, 120, 128, 3,  3,  3,  3,  1,   3,  3,  3,   1,   3,   1,   1,   1};
-    static integer rmst[64] = {1024, 936, 856, 784, 718, 656, 600, 550, 502, 460, 420, 384, 352, 328, 294, 270,
-                               246,  226, 206, 188, 172, 158, 144, 132, 120, 110, 102, 92,  84,  78,  70,  64,
-                               60,   54,  50,  46,  42,  38,  34,  32,  30,  26,  24,  22,  20,  18,  17,  16,
-                               15,   14,  13,  12,  11,  10,  9,   8,   7,   6,   5,   4,   3,   2,   1,   0};
-    static integer detab7[32] = {4,   11,  18,  25,  32,  39,  46,  53,  60,  66,  72,  77,  82,  87,  92,  96,
-                                 101, 104, 108, 111, 114, 115, 117, 119, 121, 122, 123, 124, 125, 126, 127, 127};
-    static real descl[8] = {.6953f, .625f, .5781f, .5469f, .5312f, .5391f, .4688f, .3828f};
+    static const integer rmst[64] = {1024, 936, 856, 784, 718, 656, 600, 550, 502, 460, 420, 384, 352, 328, 294, 270,
+                                     246,  226, 206, 188, 172, 158, 144, 132, 120, 110, 102, 92,  84,  78,  70,  64,
+                                     60,   54,  50,  46,  42,  38,  34,  32,  30,  26,  24,  22,  20,  18,  17,  16,
+                                     15,   14,  13,  12,  11,  10,  9,   8,   7,   6,   5,   4,   3,   2,   1,   0};
+    static const integer detab7[32] = {4,   11,  18,  25,  32,  39,  46,  53,  60,  66,  72,  77,  82,  87,  92,  96,
+                                       101, 104, 108, 111, 114, 115, 117, 119, 121, 122, 123, 124, 125, 126, 127, 127};
+    static const real descl[8] = {.6953f, .625f, .5781f, .5469f, .5312f, .5391f, .4688f, .3828f};
     integer* ivp2h;
-    static integer deadd[8] = {1152, -2816, -1536, -3584, -1280, -2432, 768, -1920};
-    static integer qb[8] = {511, 511, 1023, 1023, 1023, 1023, 2047, 4095};
-    static integer nbit[10] = {8, 8, 5, 5, 4, 4, 4, 4, 3, 2};
-    static integer zrc[10] = {0, 0, 0, 0, 0, 3, 0, 2, 0, 0};
-    static integer bit[5] = {2, 4, 8, 16, 32};
+    static const integer deadd[8] = {1152, -2816, -1536, -3584, -1280, -2432, 768, -1920};
+    static const integer qb[8] = {511, 511, 1023, 1023, 1023, 1023, 2047, 4095};
+    static const integer nbit[10] = {8, 8, 5, 5, 4, 4, 4, 4, 3, 2};
+    static const integer zrc[10] = {0, 0, 0, 0, 0, 3, 0, 2, 0, 0};
+    static const integer bit[5] = {2, 4, 8, 16, 32};
     integer* iovoic;
     integer* iavgp;
     integer* iptold;
@@ -166,13 +166,13 @@ static integer c__2 = 2;
     integer i__1, i__2;
 
     /* Builtin functions */
-    integer pow_ii(integer*, integer*);
+    integer pow_ii(const integer*, integer*);
 
     /* Local variables */
-    extern /* Subroutine */ int ham84_(integer*, integer*, integer*);
+    extern /* Subroutine */ int ham84v_(const integer*, integer*, integer*, integer*);
     integer ipit, iout, i__, icorf, index, ivoic, ixcor, i1, i2, i4;
     extern integer median_(integer*, integer*, integer*);
-    integer ishift, errcnt, lsb;
+    integer ishift, errcnt, hin[5], hout[5], hlsb[5];
 
     /*   LPC Configuration parameters: */
     /* Frame size, Prediction order, Pitch period */
@@ -300,6 +300,8 @@ static integer c__2 = 2;
     drc = &(st->drc[0]);
     dpit = &(st->dpit[0]);
     drms = &(st->drms[0]);
+    st->hamfix = 0;
+    st->hambad = 0;
 
     /* DATA statements for "constants" defined above. */
     /* 	IF (LISTL.GE.3) WRITE(FDEBUG,800) IPITV,IRMS,(IRC(J),J=1,ORDER) */
@@ -337,7 +339,7 @@ static integer c__2 = 2;
         dpit[0] = *iavgp;
     }
     drms[0] = *irms;
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
         drc[i__ * 3 - 3] = irc[i__];
     }
@@ -383,14 +385,10 @@ static integer c__2 = 2;
     /*    during transition or unvoiced frame.  If IOUT is negative, */
     /*    more than 1 error occurred, use previous frame's parameters. */
     if ((icorf & bit[3]) != 0) {
-        errcnt = 0;
-        lsb = drms[1] & 1;
-        index = (drc[22] << 4) + drms[1] / 2;
-        ham84_(&index, &iout, &errcnt);
-        drms[1] = drms[2];
-        if (iout >= 0) {
-            drms[1] = (iout << 1) + lsb;
-        }
+        /*    All five words are gathered first and corrected in one call, */
+        /*    since none of them is built from a field another one writes. */
+        hlsb[0] = drms[1] & 1;
+        hin[0] = ((drc[22] & 15) << 4) + drms[1] / 2;
         for (i__ = 1; i__ <= 4; ++i__) {
             if (i__ == 1) {
                 i1 = ((drc[25] & 7) << 1) + (drc[28] & 1);
@@ -398,11 +396,26 @@ static integer c__2 = 2;
                 i1 = drc[(9 - i__) * 3 - 2] & 15;
             }
             i2 = drc[(5 - i__) * 3 - 2] & 31;
-            lsb = i2 & 1;
-            index = (i1 << 4) + i2 / 2;
-            ham84_(&index, &iout, &errcnt);
+            hlsb[i__] = i2 & 1;
+            hin[i__] = (i1 << 4) + i2 / 2;
+        }
+        errcnt = 0;
+        ham84v_(&c__5, hin, hout, &errcnt);
+        st->hamfix = errcnt;
+        for (i__ = 0; i__ < 5; ++i__) {
+            if (hout[i__] < 0) {
+                st->hamfix -= 2;
+                ++st->hambad;
+            }
+        }
+        drms[1] = drms[2];
+        if (hout[0] >= 0) {
+            drms[1] = (hout[0] << 1) + hlsb[0];
+        }
+        for (i__ = 1; i__ <= 4; ++i__) {
+            iout = hout[i__];
             if (iout >= 0) {
-                iout = (iout << 1) + lsb;
+                iout = (iout << 1) + hlsb[i__];
                 if ((iout & 16) == 16) {
                     iout += -32;
                 }
@@ -416,7 +429,7 @@ static integer c__2 = 2;
     }
     /*  Get unsmoothed RMS, RC's, and PITCH */
     *irms = drms[1];
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
         irc[i__] = drc[i__ * 3 - 2];
     }
@@ -452,7 +465,7 @@ static integer c__2 = 2;
 /*  the values will be zero. */
 L500:
     if ((icorf & bit[4]) != 0) {
-        i__1 = contrl_1.order;
+        i__1 = LPC10_ORDER;
         for (i__ = 5; i__ <= i__1; ++i__) {
             irc[i__] = zrc[i__ - 1];
         }
@@ -464,7 +477,7 @@ L500:
     dpit[1] = dpit[0];
     drms[2] = drms[1];
     drms[1] = drms[0];
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
         drc[i__ * 3 - 1] = drc[i__ * 3 - 2];
         drc[i__ * 3 - 2] = drc[i__ * 3 - 3];
@@ -494,7 +507,7 @@ L900:
         irc[i__] = i2 * pow_ii(&c__2, &ishift);
     }
     /*  Decode RC(3)-RC(10) to sign plus 14 bits */
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 3; i__ <= i__1; ++i__) {
         i2 = irc[i__];
         ishift = 15 - nbit[i__ - 1];
@@ -506,7 +519,7 @@ L900:
     /* 811	FORMAT(1X,'<<DECODE OUT>>',T45,I4,1X,10I8) */
     /*  Scale RMS and RC's to reals */
     *rms = (real)(*irms);
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
         rc[i__] = irc[i__] / 16384.f;
     }
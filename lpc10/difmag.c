@@ -14,7 +14,14 @@
 #include "f2c.h"
 
 extern int
-difmag_(real* speech, integer* lpita, integer* tau, integer* ltau, integer* maxlag, real* amdf, integer* minptr, integer* maxptr);
+difmag_(real* speech,
+        const integer* lpita,
+        const integer* tau,
+        const integer* ltau,
+        const integer* maxlag,
+        real* amdf,
+        integer* minptr,
+        integer* maxptr);
 
 /* ********************************************************************** */
 
@@ -61,10 +68,10 @@ difmag_(real* speech, integer* lpita, integer* tau, integer* ltau, integer* maxl
 /* This subroutine has no local state. */
 
 /* Subroutine */ int difmag_(real* speech,
-                             integer* lpita,
-                             integer* tau,
-                             integer* ltau,
-                             integer* maxlag,
+                             const integer* lpita,
+                             const integer* tau,
+                             const integer* ltau,
+                             const integer* maxlag,
                              real* amdf,
                              integer* minptr,
                              integer* maxptr) {
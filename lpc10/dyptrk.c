@@ -22,22 +22,13 @@
 #include "f2c.h"
 
 extern int dyptrk_(real* amdf,
-                   integer* ltau,
+                   const integer* ltau,
                    integer* minptr,
                    integer* voice,
                    integer* pitch,
                    integer* midx,
                    struct lpc10_encoder_state* st);
 
-/* Common Block Declarations */
-
-extern struct {
-    integer order, lframe;
-    logical corrp;
-} contrl_;
-
-#define contrl_1 contrl_
-
 /* ********************************************************************* */
 
 /* 	DYPTRK Version 52 */
@@ -93,7 +84,8 @@ extern struct {
 /*  MINPTR - Location of minimum AMDF value */
 /*  VOICE  - Voicing decision */
 /* Output: */
-/*  PITCH  - Smoothed pitch value, 2 frames delayed */
+/*  PITCH  - Smoothed pitch value, 2 frames delayed (1 frame if */
+/*           LOWDELAY is set in the encoder state) */
 /*  MIDX   - Initial estimate of current frame pitch */
 /* Compile time constant: */
 /*  DEPTH  - Number of frames to trace back */
@@ -104,7 +96,7 @@ extern struct {
 /* INITDYPTRK. */
 
 /* Subroutine */ int dyptrk_(real* amdf,
-                             integer* ltau,
+                             const integer* ltau,
                              integer* minptr,
                              integer* voice,
                              integer* pitch,
@@ -122,8 +114,9 @@ extern struct {
 
     /* Local variables */
     integer pbar;
-    real sbar;
+    real sbar, si;
     integer iptr, i__, j;
+    logical lt;
     real alpha, minsc, maxsc;
 
     /*       Arguments */
@@ -263,22 +256,24 @@ extern struct {
     /* SEESAW: Construct a pitch pointer array and intermediate winner functio
     n*/
     /*   Left to right pass: */
+    /*   This is a running minimum (a min-plus prefix scan) of S with a */
+    /*   cost of ALPHA per lag step.  It is evaluated serially, with */
+    /*   selects instead of branches, because S is carried from frame to */
+    /*   frame and the repeated additions of ALPHA must round exactly as */
+    /*   before for PITCH to stay the same.  The subtraction of MINSC */
+    /*   from the last frame is done here, as S is read. */
     iptr = *ipoint + 1;
-    p[iptr * 60 - 60] = 1;
-    i__ = 1;
+    sbar = s[0] - st->minsc;
     pbar = 1;
-    sbar = s[0];
     i__1 = *ltau;
     for (i__ = 1; i__ <= i__1; ++i__) {
+        si = s[i__ - 1] - st->minsc;
         sbar += alpha;
-        if (sbar < s[i__ - 1]) {
-            s[i__ - 1] = sbar;
-            p[i__ + iptr * 60 - 61] = pbar;
-        } else {
-            sbar = s[i__ - 1];
-            p[i__ + iptr * 60 - 61] = i__;
-            pbar = i__;
-        }
+        lt = sbar < si;
+        sbar = lt ? sbar : si;
+        pbar = lt ? pbar : i__;
+        s[i__ - 1] = sbar;
+        p[i__ + iptr * 60 - 61] = pbar;
     }
     /*   Right to left pass: */
     i__ = pbar - 1;
@@ -296,42 +291,41 @@ extern struct {
         --i__;
     }
     /*   Update S using AMDF */
-    /*   Find maximum, minimum, and location of minimum */
+    /*   Find maximum, minimum, and location of minimum, in the same pass */
     s[0] += amdf[1] / 2;
     minsc = s[0];
     maxsc = minsc;
     *midx = 1;
     i__1 = *ltau;
     for (i__ = 2; i__ <= i__1; ++i__) {
-        s[i__ - 1] += amdf[i__] / 2;
-        if (s[i__ - 1] > maxsc) {
-            maxsc = s[i__ - 1];
-        }
-        if (s[i__ - 1] < minsc) {
-            *midx = i__;
-            minsc = s[i__ - 1];
-        }
-    }
-    /*   Subtract MINSC from S to prevent overflow */
-    i__1 = *ltau;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-        s[i__ - 1] -= minsc;
+        si = s[i__ - 1] + amdf[i__] / 2;
+        s[i__ - 1] = si;
+        maxsc = si > maxsc ? si : maxsc;
+        lt = si < minsc;
+        *midx = lt ? i__ : *midx;
+        minsc = lt ? si : minsc;
     }
+    /*   Subtract MINSC from S to prevent overflow.  This is deferred to */
+    /*   the left to right pass of the next frame; until then S(I)-MINSC */
+    /*   is used wherever the normalized S is needed. */
+    st->minsc = minsc;
     maxsc -= minsc;
     /*   Use higher octave pitch if significant null there */
     j = 0;
     for (i__ = 20; i__ <= 40; i__ += 10) {
         if (*midx > i__) {
-            if (s[*midx - i__ - 1] < maxsc / 4) {
+            if (s[*midx - i__ - 1] - minsc < maxsc / 4) {
                 j = i__;
             }
         }
     }
     *midx -= j;
-    /*   TRACE: look back two frames to find minimum cost pitch estimate */
+    /*   TRACE: look back two frames to find minimum cost pitch estimate, */
+    /*   or one frame in low-delay mode */
     j = *ipoint;
     *pitch = *midx;
-    for (i__ = 1; i__ <= 2; ++i__) {
+    i__1 = st->lowdelay ? 1 : 2;
+    for (i__ = 1; i__ <= i__1; ++i__) {
         j = j % 2 + 1;
         *pitch = p[*pitch + j * 60 - 61];
     }
@@ -56,6 +56,7 @@ extern int energy_(integer* len, real* speech, real* rms);
 
     /* Local variables */
     integer i__;
+    real sum;
 
     /*       Arguments */
     /*       Local variables that need not be saved */
@@ -63,11 +64,13 @@ extern int energy_(integer* len, real* speech, real* rms);
     --speech;
 
     /* Function Body */
-    *rms = 0.f;
+    /*       Summed in a local, since RMS could alias SPEECH and would */
+    /*       otherwise be stored back on every iteration. */
+    sum = 0.f;
     i__1 = *len;
     for (i__ = 1; i__ <= i__1; ++i__) {
-        *rms += speech[i__] * speech[i__];
+        sum += speech[i__] * speech[i__];
     }
-    *rms = sqrt(*rms / *len);
+    *rms = sqrt(sum / *len);
     return 0;
 } /* energy_ */
@@ -26,9 +26,9 @@ with anything else, and I'll get on that case before we go stable.
 
 #include "f2c.h"
 
-integer pow_ii(integer* ap, integer* bp);
+integer pow_ii(const integer* ap, integer* bp);
 
-integer pow_ii(integer* ap, integer* bp) {
+integer pow_ii(const integer* ap, integer* bp) {
     integer pow, x, n;
     unsigned long u;
 
@@ -54,9 +54,9 @@ integer pow_ii(integer* ap, integer* bp) {
     return (pow);
 }
 
-double r_sign(real* a, real* b);
+double r_sign(const real* a, real* b);
 
-double r_sign(real* a, real* b) {
+double r_sign(const real* a, real* b) {
     double x;
     x = (*a >= 0 ? *a : -*a);
     return (*b >= 0 ? x : -x);
@@ -14,6 +14,7 @@
 #include "f2c.h"
 
 extern int ham84_(integer* input, integer* output, integer* errcnt);
+extern int ham84v_(const integer* n, integer* input, integer* output, integer* errcnt);
 
 /* ***************************************************************** */
 
@@ -47,49 +48,51 @@ extern int ham84_(integer* input, integer* output, integer* errcnt);
 /*  OUTPUT - 4 corrected parameter bits */
 
 /* This subroutine is entered with an eight bit word in INPUT.  The 8th */
-/* bit is parity and is stripped off.  The remaining 7 bits address the */
-/* hamming 8,4 table and the output OUTPUT from the table gives the 4 */
-/* bits of corrected data.  If bit 4 is set, no error was detected. */
+/* bit is parity.  The 7 bits below it address the Hamming 8,4 table, */
+/* which gives the 4 bits of corrected data, and together with the */
+/* parity bit they tell how many errors were detected.  Both are */
+/* looked up at once in HAMTAB, which is indexed by all 8 bits: */
+/*  bits 0-4 - OUTPUT as a 5 bit two's complement number, so that the */
+/*             -1 for an uncorrectable word is 31 */
+/*  bits 5-6 - Number of errors to add to ERRCNT (0, 1 or 2) */
 /* ERRCNT is the number of errors counted. */
 
 /* This subroutine has no local state. */
 
+static const unsigned char hamtab[256] = {
+    0,  32, 32, 95, 32, 95, 95, 39, 32, 95, 95, 43, 95, 45, 46, 95, 32, 95, 95, 39, 95, 39, 39, 7,  95, 41, 42, 95, 44, 95, 95, 39,
+    32, 95, 95, 43, 95, 37, 38, 95, 95, 43, 43, 11, 44, 95, 95, 43, 95, 33, 34, 95, 44, 95, 95, 39, 44, 95, 95, 43, 12, 44, 44, 95,
+    32, 95, 95, 35, 95, 45, 38, 95, 95, 45, 42, 95, 45, 13, 95, 45, 95, 33, 42, 95, 36, 95, 95, 39, 42, 95, 10, 42, 95, 45, 42, 95,
+    95, 33, 38, 95, 38, 95, 6,  38, 40, 95, 95, 43, 95, 45, 38, 95, 33, 1,  95, 33, 95, 33, 38, 95, 95, 33, 42, 95, 44, 95, 95, 47,
+    32, 95, 95, 35, 95, 37, 46, 95, 95, 41, 46, 95, 46, 95, 14, 46, 95, 41, 34, 95, 36, 95, 95, 39, 41, 9,  95, 41, 95, 41, 46, 95,
+    95, 37, 34, 95, 37, 5,  95, 37, 40, 95, 95, 43, 95, 37, 46, 95, 34, 95, 2,  34, 95, 37, 34, 95, 95, 41, 34, 95, 44, 95, 95, 47,
+    95, 35, 35, 3,  36, 95, 95, 35, 40, 95, 95, 35, 95, 45, 46, 95, 36, 95, 95, 35, 4,  36, 36, 95, 95, 41, 42, 95, 36, 95, 95, 47,
+    40, 95, 95, 35, 95, 37, 38, 95, 8,  40, 40, 95, 40, 95, 95, 47, 95, 33, 34, 95, 36, 95, 95, 47, 40, 95, 95, 47, 95, 47, 47, 15};
+
 /* Subroutine */ int ham84_(integer* input, integer* output, integer* errcnt) {
-    /* Initialized data */
-
-    static integer dactab[128] = {
-        16, 0, 0, 3,  0, 5,  14, 7, 0,  9,  14, 11, 14, 13, 30, 14, 0, 9,  2,  7, 4,  7, 7, 23, 9,  25, 10, 9,  12, 9,  14, 7,
-        0,  5, 2, 11, 5, 21, 6,  5, 8,  11, 11, 27, 12, 5,  14, 11, 2, 1,  18, 2, 12, 5, 2, 7,  12, 9,  2,  11, 28, 12, 12, 15,
-        0,  3, 3, 19, 4, 13, 6,  3, 8,  13, 10, 3,  13, 29, 14, 13, 4, 1,  10, 3, 20, 4, 4, 7,  10, 9,  26, 10, 4,  13, 10, 15,
-        8,  1, 6, 3,  6, 5,  22, 6, 24, 8,  8,  11, 8,  13, 6,  15, 1, 17, 2,  1, 4,  1, 6, 15, 8,  1,  10, 15, 12, 15, 15, 31};
-
-    integer i__, j, parity;
-
-    /*       Arguments */
-    /*       Parameters/constants */
-    /*       Local variables that need not be saved */
-    /*  Determine parity of input word */
-    parity = *input & 255;
-    parity ^= parity / 16;
-    parity ^= parity / 4;
-    parity ^= parity / 2;
-    parity &= 1;
-    i__ = dactab[*input & 127];
-    *output = i__ & 15;
-    j = i__ & 16;
-    if (j != 0) {
-        /*          No errors detected in seven bits */
-        if (parity != 0) {
-            ++(*errcnt);
-        }
-    } else {
-        /*          One or two errors detected */
-        ++(*errcnt);
-        if (parity == 0) {
-            /*             Two errors detected */
-            ++(*errcnt);
-            *output = -1;
-        }
-    }
+    integer i__;
+
+    i__ = hamtab[*input & 255];
+    *output = ((i__ & 31) ^ 16) - 16;
+    *errcnt += i__ >> 5;
     return 0;
 } /* ham84_ */
+
+/* ***************************************************************** */
+
+/*  Hamming 8,4 decode N words at once, e.g. all protected fields of */
+/*  a frame.  INPUT, OUTPUT and ERRCNT are as for HAM84, with INPUT and */
+/*  OUTPUT indices 1 through N read and written. */
+
+/* Subroutine */ int ham84v_(const integer* n, integer* input, integer* output, integer* errcnt) {
+    integer i__, e;
+
+    e = 0;
+    for (i__ = 0; i__ < *n; ++i__) {
+        integer t = hamtab[input[i__] & 255];
+        output[i__] = ((t & 31) ^ 16) - 16;
+        e += t >> 5;
+    }
+    *errcnt += e;
+    return 0;
+} /* ham84v_ */
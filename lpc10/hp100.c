@@ -21,7 +21,7 @@
 
 #include "f2c.h"
 
-extern int hp100_(real* speech, integer* start, integer* end, struct lpc10_encoder_state* st);
+extern int hp100_(real* speech, const integer* start, const integer* end, struct lpc10_encoder_state* st);
 extern int inithp100_(void);
 
 /* ********************************************************************* */
@@ -47,7 +47,7 @@ extern int inithp100_(void);
 /* you want to switch to using a new audio stream for this filter, or */
 /* reinitialize its state for any other reason, call the ENTRY */
 /* INITHP100. */
-/* Subroutine */ int hp100_(real* speech, integer* start, integer* end, struct lpc10_encoder_state* st) {
+/* Subroutine */ int hp100_(real* speech, const integer* start, const integer* end, struct lpc10_encoder_state* st) {
     /* Temporary local copies of variables in lpc10_encoder_state.
        I've only created these because it might cause the loop below
        to execute a bit faster to access local variables, rather than
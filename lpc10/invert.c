@@ -13,7 +13,7 @@
 
 #include "f2c.h"
 
-extern int invert_(integer* order, real* phi, real* psi, real* rc);
+extern int invert_(const integer* order, real* phi, real* psi, real* rc);
 
 /* **************************************************************** */
 
@@ -62,7 +62,7 @@ extern int invert_(integer* order, real* phi, real* psi, real* rc);
 /*  NOTE: Temporary matrix V is not needed and may be replaced */
 /*    by PHI if the original PHI values do not need to be preserved. */
 
-/* Subroutine */ int invert_(integer* order, real* phi, real* psi, real* rc) {
+/* Subroutine */ int invert_(const integer* order, real* phi, real* psi, real* rc) {
     /* System generated locals */
     integer phi_dim1, phi_offset, i__1, i__2, i__3;
     real r__1, r__2;
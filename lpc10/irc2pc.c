@@ -13,7 +13,7 @@
 
 #include "f2c.h"
 
-extern int irc2pc_(real* rc, real* pc, integer* order, real* gprime, real* g2pass);
+extern int irc2pc_(real* rc, real* pc, const integer* order, const real* gprime, real* g2pass);
 
 /* ***************************************************************** */
 
@@ -51,7 +51,7 @@ extern int irc2pc_(real* rc, real* pc, integer* order, real* gprime, real* g2pas
 
 /* This subroutine has no local state. */
 
-/* Subroutine */ int irc2pc_(real* rc, real* pc, integer* order, real* gprime, real* g2pass) {
+/* Subroutine */ int irc2pc_(real* rc, real* pc, const integer* order, const real* gprime, real* g2pass) {
     /* System generated locals */
     integer i__1, i__2;
 
@@ -13,7 +13,7 @@
 
 #include "f2c.h"
 
-extern int ivfilt_(real* lpbuf, real* ivbuf, integer* len, integer* nsamp, real* ivrc);
+extern int ivfilt_(real* lpbuf, real* ivbuf, const integer* len, const integer* nsamp, real* ivrc);
 
 /* ********************************************************************* */
 
@@ -52,7 +52,7 @@ extern int ivfilt_(real* lpbuf, real* ivbuf, integer* len, integer* nsamp, real*
 
 /* This subroutine has no local state. */
 
-/* Subroutine */ int ivfilt_(real* lpbuf, real* ivbuf, integer* len, integer* nsamp, real* ivrc) {
+/* Subroutine */ int ivfilt_(real* lpbuf, real* ivbuf, const integer* len, const integer* nsamp, real* ivrc) {
     /* System generated locals */
     integer i__1;
 
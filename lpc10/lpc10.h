@@ -40,6 +40,7 @@ with anything else, and I'll get on that case before we go stable.
 #define dyptrk_ lsx_lpc10_dyptrk_
 #define energy_ lsx_lpc10_energy_
 #define ham84_ lsx_lpc10_ham84_
+#define ham84v_ lsx_lpc10_ham84v_
 #define hp100_ lsx_lpc10_hp100_
 #define i_nint lsx_lpc10_i_nint
 #define init_lpc10_decoder_state lsx_lpc10_init_decoder_state
@@ -47,8 +48,32 @@ with anything else, and I'll get on that case before we go stable.
 #define invert_ lsx_lpc10_invert_
 #define irc2pc_ lsx_lpc10_irc2pc_
 #define ivfilt_ lsx_lpc10_ivfilt_
+#define lpc10_analyze lsx_lpc10_analyze
+#define lpc10_conceal lsx_lpc10_conceal
 #define lpc10_decode lsx_lpc10_decode
+#define lpc10_decode_s16 lsx_lpc10_decode_s16
+#define lpc10_decode_skip lsx_lpc10_decode_skip
+#define lpc10_decoder_state_restore lsx_lpc10_decoder_state_restore
+#define lpc10_decoder_state_save lsx_lpc10_decoder_state_save
+#define lpc10_dequantize lsx_lpc10_dequantize
 #define lpc10_encode lsx_lpc10_encode
+#define lpc10_encode_chunk lsx_lpc10_encode_chunk
+#define lpc10_encode_s16 lsx_lpc10_encode_s16
+#define lpc10_encoder_state_restore lsx_lpc10_encoder_state_restore
+#define lpc10_encoder_state_save lsx_lpc10_encoder_state_save
+#define lpc10_file_header_read lsx_lpc10_file_header_read
+#define lpc10_file_header_write lsx_lpc10_file_header_write
+#define lpc10_file_index_read lsx_lpc10_file_index_read
+#define lpc10_file_index_write lsx_lpc10_file_index_write
+#define lpc10_file_sync_bytes lsx_lpc10_file_sync_bytes
+#define lpc10_file_sync_read lsx_lpc10_file_sync_read
+#define lpc10_file_sync_write lsx_lpc10_file_sync_write
+#define lpc10_profile_name lsx_lpc10_profile_name
+#define lpc10_profile_reset lsx_lpc10_profile_reset
+#define lpc10_profile_unit lsx_lpc10_profile_unit
+#define lpc10_quantize lsx_lpc10_quantize
+#define lpc10_speech_to_s16 lsx_lpc10_speech_to_s16
+#define lpc10_synthesize lsx_lpc10_synthesize
 #define lpcini_ lsx_lpc10_lpcini_
 #define lpfilt_ lsx_lpc10_lpfilt_
 #define median_ lsx_lpc10_median_
@@ -61,8 +86,10 @@ with anything else, and I'll get on that case before we go stable.
 #define preemp_ lsx_lpc10_preemp_
 #define prepro_ lsx_lpc10_prepro_
 #define random_ lsx_lpc10_random_
+#define random_skip_ lsx_lpc10_random_skip_
 #define rcchk_ lsx_lpc10_rcchk_
 #define r_sign lsx_lpc10_r_sign
+#define synctl_ lsx_lpc10_synctl_
 #define synths_ lsx_lpc10_synths_
 #define tbdm_ lsx_lpc10_tbdm_
 #define voicin_ lsx_lpc10_voicin_
@@ -71,6 +98,94 @@ with anything else, and I'll get on that case before we go stable.
 #define LPC10_SAMPLES_PER_FRAME 180
 #define LPC10_BITS_IN_COMPRESSED_FRAME 54
 
+/* Stream layouts of lpc10_encode_s16 and lpc10_decode_s16: a frame in */
+/* 7 bytes, the last 2 bits 0, or with tight packing every 4 frames in */
+/* 27 bytes.  Bits go least significant bit of each byte first. */
+#define LPC10_BYTES_IN_COMPRESSED_FRAME 7
+#define LPC10_TIGHT_FRAMES 4
+#define LPC10_TIGHT_BYTES 27
+
+/* Bytes lpc10_encode_s16 writes for nsamples samples, and samples */
+/* lpc10_decode_s16 writes for nbytes bytes. */
+#define LPC10_ENCODED_BYTES(nsamples, tight)                                                                                 \
+    ((tight) ? ((nsamples) + LPC10_TIGHT_FRAMES * LPC10_SAMPLES_PER_FRAME - 1) / (LPC10_TIGHT_FRAMES * LPC10_SAMPLES_PER_FRAME) * \
+                   LPC10_TIGHT_BYTES                                                                                         \
+             : ((nsamples) + LPC10_SAMPLES_PER_FRAME - 1) / LPC10_SAMPLES_PER_FRAME * LPC10_BYTES_IN_COMPRESSED_FRAME)
+#define LPC10_DECODED_SAMPLES(nbytes, tight)                                                                    \
+    ((tight) ? (nbytes) / LPC10_TIGHT_BYTES * LPC10_TIGHT_FRAMES * LPC10_SAMPLES_PER_FRAME                     \
+             : (nbytes) / LPC10_BYTES_IN_COMPRESSED_FRAME * LPC10_SAMPLES_PER_FRAME)
+
+/* Frames between reading a frame of speech and returning its bits, on top
+   of the frame itself: normally, and with lowdelay set in the encoder state.
+   The analysis frame is already one frame behind the newest input, and the
+   frame returned is one or two frames behind that. */
+#define LPC10_ENCODER_DELAY 3
+#define LPC10_ENCODER_LOW_DELAY 2
+
+/* Frames between decoding a frame's bits and returning its speech: one
+   for the median smoothing in decode_, and one for the buffer in synths_
+   that holds the up to one pitch period of speech synthesized beyond the
+   end of a frame. */
+#define LPC10_DECODER_DELAY 2
+
+/* Frames of warm-up lpc10_encode_chunk is meant to be given (4.5 s). */
+/* Most of the encoder state only reaches back a few frames, but the */
+/* signal and noise levels voicin_ tracks take longer, and a decision */
+/* that comes out differently can be followed by others.  With 50 */
+/* frames, up to 2.5% of the frames of a chunk still differed from a */
+/* sequential encoding in our recordings.  With this many, 35 minutes */
+/* in 8 chunks had 293 frames (0.3%) differ, in runs reaching about */
+/* 400 frames past a chunk start; a synthetic 35 minutes of varying */
+/* levels had 581 (0.6%), up to 1476 frames past one, and none only */
+/* with 1600 frames of warm-up.  Chunked encoding is not exact. */
+#define LPC10_CHUNK_WARMUP 200
+
+/* Frames of pre-roll the decoder needs after lpc10_decode_skip (4.5 s). */
+/* Only the memory of the synthesis filters is left to settle by then, */
+/* and it settles slowly to the last bit: with 16 frames, samples of */
+/* about 2% of the frames that follow were still 1 off, with 100 frames */
+/* 0.3%, and from 150 frames on none were in our recordings. */
+#define LPC10_CHUNK_PREROLL 200
+
+/* Version of the layout lpc10_*_state_save write, and the most bytes */
+/* they write. */
+#define LPC10_STATE_VERSION 1
+#define LPC10_ENCODER_STATE_BYTES 9714
+#define LPC10_DECODER_STATE_BYTES 1165
+
+/* The LPC-10 file format (lpcfile.c): its version, the size of its */
+/* header, of a sync point without and with the most decoder state, */
+/* and of an index of count sync points. */
+#define LPC10_FILE_VERSION 1
+#define LPC10_FILE_HEADER_BYTES 32
+#define LPC10_FILE_SYNC_HEAD 18
+#define LPC10_FILE_SYNC_BYTES (LPC10_FILE_SYNC_HEAD + LPC10_DECODER_STATE_BYTES)
+#define LPC10_FILE_INDEX_BYTES(count) (8 + 16 * (count))
+
+/* Frames between the sync points of a file (54 s).  Seeking decodes */
+/* up to this many frames from the sync point before the target, a */
+/* few ms of work; the decoder states take about 6% of the file. */
+#define LPC10_FILE_SYNC_FRAMES 2400
+
+/*
+  The LPC order and the frame length the codec core is built for.  They
+  used to be read at run time from the CONTRL common block; as
+  compile-time constants they let the compiler unroll or vectorize the
+  loops they bound.  The quantizer tables, the 54-bit frame layout and
+  the buffers in the state structures below are only defined for order
+  10 and 180-sample frames, so a variant needs its own tables as well as
+  new values here.
+*/
+#ifndef LPC10_ORDER
+#define LPC10_ORDER 10
+#endif
+#ifndef LPC10_LFRAME
+#define LPC10_LFRAME LPC10_SAMPLES_PER_FRAME
+#endif
+#if LPC10_ORDER != 10 || LPC10_LFRAME != 180
+#error LPC10_ORDER and LPC10_LFRAME other than 10 and 180 need their own quantizer tables and buffer sizes.
+#endif
+
 #if defined(SHRT_MAX) && defined(SHRT_MIN) && SHRT_MAX == 32767 && SHRT_MIN == (-32768)
 typedef short INT16;
 #elif defined(INT_MAX) && defined(INT_MIN) && INT_MAX == 32767 && INT_MIN == (-32768)
@@ -99,6 +214,38 @@ typedef INT32 integer;
 typedef INT32 logical;
 typedef INT16 shortint;
 
+/*
+  Built with LPC10_PROFILE defined (cmake -DLPC10_PROFILE=ON), analys_
+  and synths_ time each of their major stages, and add the time and the
+  number of calls to the prof member of the state.  The time is counted
+  in lpc10_profile_unit(): TSC cycles on x86, nanoseconds elsewhere.
+  Without it, neither the counters nor the code that updates them exist.
+*/
+#ifdef LPC10_PROFILE
+enum lpc10_profile_stage {
+    /* analys_ */
+    LPC10_PROF_LPFILT, /* 800 Hz low-pass filter */
+    LPC10_PROF_IVFILT, /* 2nd order inverse filter */
+    LPC10_PROF_TBDM,   /* AMDF pitch search */
+    LPC10_PROF_VOICIN, /* voicing decisions, both half frames */
+    LPC10_PROF_DYPTRK, /* dynamic programming pitch tracker */
+    LPC10_PROF_PLACE,  /* placev_ and placea_ window placement */
+    LPC10_PROF_MLOAD,  /* covariance matrix load */
+    LPC10_PROF_INVERT, /* covariance matrix inversion */
+    /* synths_ */
+    LPC10_PROF_PITSYN, /* pitch-synchronous parameter interpolation */
+    LPC10_PROF_IRC2PC, /* reflection to predictor coefficients */
+    LPC10_PROF_BSYNZ,  /* excitation and synthesis filter */
+    LPC10_PROF_DEEMP,  /* de-emphasis */
+    LPC10_PROF_STAGES
+};
+
+struct lpc10_profile {
+    unsigned long long ticks[LPC10_PROF_STAGES];
+    unsigned long long calls[LPC10_PROF_STAGES];
+};
+#endif
+
 struct lpc10_encoder_state {
     /* State used only by function hp100 */
     real z11;
@@ -119,11 +266,12 @@ struct lpc10_encoder_state {
     real rmsbuf[3];
     real rcbuf[30] /* was [10][3] */;
     real zpre;
+    logical lowdelay; /* initial value FALSE_; see the calling sequence below */
 
     /* State used by function onset */
     real n;
     real d__; /* initial value 1.f */
-    real fpc; /* no initial value necessary */
+    real fpc;
     real l2buf[16];
     real l2sum1;
     integer l2ptr1; /* initial value 1 */
@@ -156,9 +304,14 @@ struct lpc10_encoder_state {
     integer p[120] /* was [60][2] */;
     integer ipoint;
     real alphax;
+    real minsc; /* Not yet subtracted from S */
 
     /* State used by function chanwr */
     integer isync;
+
+#ifdef LPC10_PROFILE
+    struct lpc10_profile prof; /* initial value all 0 */
+#endif
 };
 
 struct lpc10_decoder_state {
@@ -172,10 +325,16 @@ struct lpc10_decoder_state {
     integer drc[30] /* was [3][10] */;
     integer dpit[3];
     integer drms[3];
+    integer hamfix; /* Hamming words corrected in the last frame */
+    integer hambad; /* Hamming words with uncorrectable errors in the last frame */
 
     /* State used by function synths */
     real buf[360];
     integer buflen; /* initial value 180 */
+    logical silent; /* TRUE_ if the last frame took the silence path */
+
+    /* State used by function lpc10_conceal */
+    integer nlost; /* consecutive frames concealed (at most 4), 0 after lpc10_decode */
 
     /* State used by function pitsyn */
     integer ivoico;       /* no initial value necessary as long as first_pitsyn is initially TRUE_ */
@@ -208,6 +367,24 @@ struct lpc10_decoder_state {
     real deo1;
     real deo2;
     real deo3;
+
+#ifdef LPC10_PROFILE
+    struct lpc10_profile prof; /* initial value all 0 */
+#endif
+};
+
+/* The header of an LPC-10 file, and the sync points of its index. */
+
+struct lpc10_file_header {
+    int tight;         /* nonzero for tight packing */
+    int rate;          /* sample rate, 8000 */
+    long long nframes; /* frames in the file, -1 if not known */
+    long long index;   /* offset of the index, 0 if there is none */
+};
+
+struct lpc10_file_sync {
+    long long frame;  /* number of the frame after the sync point */
+    long long offset; /* offset of the sync point in the file */
 };
 
 /*
@@ -225,6 +402,17 @@ struct lpc10_decoder_state {
   frame of encoded speech.  Once at the beginning of execution, done
   automatically for you by create_lpc10_encoder_state(), is enough.
 
+  lpc10_encode returns the bits for the frame it read
+  LPC10_ENCODER_DELAY calls earlier, because the analysis windows are
+  placed one frame back from the newest input, and the pitch tracker and
+  the voicing smoother look a further two frames ahead.  Setting the lowdelay member of the
+  lpc10_encoder_state to TRUE_ shortens this to LPC10_ENCODER_LOW_DELAY
+  calls (22.5 ms less delay): each frame's voicing is then smoothed with
+  one frame of look-ahead instead of two, and its pitch is traced back
+  one frame instead of two, so voicing and pitch errors are somewhat more
+  frequent.  It can be changed between any two frames; the frame at the
+  switch is repeated or skipped once.
+
   init_lpc10_encoder_state() reinitializes the lpc10_encoder_state
   structure.  This might be useful if you are finished processing one
   sound sample, and want to reuse the same lpc10_encoder_state
@@ -252,16 +440,90 @@ struct lpc10_decoder_state {
   only significant difference is that the array bits[] is read
   (indices 0 through (LPC10_BITS_IN_COMPRESSED_FRAME-1)), and the
   array speech[] is written (indices 0 through
-  (LPC10_SAMPLES_PER_FRAME-1)).
+  (LPC10_SAMPLES_PER_FRAME-1)).  Apart from the interpolation between
+  frames, the speech it writes is that of the bits passed
+  LPC10_DECODER_DELAY calls earlier; the first calls return silence.
+
+  lpc10_encode is lpc10_analyze followed by lpc10_quantize, and
+  lpc10_decode is lpc10_dequantize followed by lpc10_synthesize.  They
+  can be called separately to time the stages or to get at the frame
+  parameters in between: voice[] (indices 0 and 1, the voicing of each
+  half frame), pitch, rms and rc[] (indices 0 through 9, the reflection
+  coefficients).  The hamfix and hambad members of the
+  lpc10_decoder_state count the Hamming protected words of the last
+  frame lpc10_dequantize read that were corrected, or had errors too
+  many to correct.
+
+  lpc10_encode_s16 and lpc10_decode_s16 run lpc10_encode and
+  lpc10_decode over whole runs of 16-bit samples, converting to and
+  from the real samples and packing the bits into the stream layouts
+  above, the same way lpc10enc and lpc10dec do.  Samples are read as
+  pcm / 32768, and written by lpc10_speech_to_s16, which lpc10dec uses
+  too: speech * 32768 clamped to 16 bits and truncated toward zero.
+
+  lpc10_conceal writes indices 0 through (LPC10_SAMPLES_PER_FRAME-1)
+  of array speech[] with a frame extrapolated from the previously
+  decoded ones, for use in place of a frame that was lost.  Call it
+  once per missing frame, in the position the frame would have had;
+  consecutive calls fade the output out.  As lpc10_decode puts out
+  each frame one frame late, the frame received last before a loss
+  comes out after the concealed ones, in place of the first frame
+  received after it.
+
+  lpc10_encoder_state_save and lpc10_decoder_state_save write a state
+  to at most LPC10_ENCODER_STATE_BYTES or LPC10_DECODER_STATE_BYTES
+  bytes, in a layout that does not depend on the platform, and return
+  how many.  lpc10_*_state_restore read it back into a state, which
+  then carries on the stream as the saved one would have, and return
+  the bytes read; or -1, leaving the state alone, if the bytes are not
+  a state of that kind saved in LPC10_STATE_VERSION.  A decoder state
+  saves to about a third of the size of its structure; an encoder
+  state, mostly buffered speech, to a little less than its structure.
+
+  The lpc10_file_* functions write and read the parts of an LPC-10
+  file (see lpcfile.c): a header, sync points, each the decoder state
+  before the frames that follow it, and an index of the sync points at
+  the end.  Decoding can start at any sync point by restoring its
+  state, and gives the samples that decoding from the start gives.
 
   */
 
 struct lpc10_encoder_state* create_lpc10_encoder_state(void);
 void init_lpc10_encoder_state(struct lpc10_encoder_state* st);
 int lpc10_encode(real* speech, INT32* bits, struct lpc10_encoder_state* st);
+int lpc10_analyze(real* speech, INT32* voice, INT32* pitch, real* rms, real* rc, struct lpc10_encoder_state* st);
+int lpc10_quantize(INT32* voice, INT32* pitch, real* rms, real* rc, INT32* bits, struct lpc10_encoder_state* st);
+int lpc10_encode_s16(const INT16* pcm, int nsamples, unsigned char* bytes, int tight, struct lpc10_encoder_state* st);
+int lpc10_encode_chunk(const INT16* pcm, int nsamples, int first, int nframes, int warmup, unsigned char* bytes, int tight,
+                       struct lpc10_encoder_state* st);
+int lpc10_encoder_state_save(const struct lpc10_encoder_state* st, unsigned char* bytes);
+int lpc10_encoder_state_restore(struct lpc10_encoder_state* st, const unsigned char* bytes, int nbytes);
 
 struct lpc10_decoder_state* create_lpc10_decoder_state(void);
 void init_lpc10_decoder_state(struct lpc10_decoder_state* st);
 int lpc10_decode(INT32* bits, real* speech, struct lpc10_decoder_state* st);
+int lpc10_dequantize(INT32* bits, INT32* voice, INT32* pitch, real* rms, real* rc, struct lpc10_decoder_state* st);
+int lpc10_synthesize(INT32* voice, INT32* pitch, real* rms, real* rc, real* speech, struct lpc10_decoder_state* st);
+int lpc10_conceal(real* speech, struct lpc10_decoder_state* st);
+int lpc10_decode_s16(const unsigned char* bytes, int nbytes, INT16* pcm, int tight, struct lpc10_decoder_state* st);
+void lpc10_speech_to_s16(const real* speech, INT16* pcm, int n);
+void lpc10_decode_skip(const unsigned char* bytes, int nframes, int tight, struct lpc10_decoder_state* st);
+int lpc10_decoder_state_save(const struct lpc10_decoder_state* st, unsigned char* bytes);
+int lpc10_decoder_state_restore(struct lpc10_decoder_state* st, const unsigned char* bytes, int nbytes);
+
+int lpc10_file_header_write(const struct lpc10_file_header* h, unsigned char* bytes);
+int lpc10_file_header_read(struct lpc10_file_header* h, const unsigned char* bytes, int nbytes);
+int lpc10_file_sync_write(long long frame, int nframes, const struct lpc10_decoder_state* st, unsigned char* bytes);
+int lpc10_file_sync_bytes(const unsigned char* bytes, int nbytes);
+int lpc10_file_sync_read(long long* frame, int* nframes, struct lpc10_decoder_state* st, const unsigned char* bytes,
+                         int nbytes);
+int lpc10_file_index_write(const struct lpc10_file_sync* syncs, int count, unsigned char* bytes);
+int lpc10_file_index_read(struct lpc10_file_sync* syncs, int max, const unsigned char* bytes, int nbytes);
+
+#ifdef LPC10_PROFILE
+const char* lpc10_profile_name(int stage);
+const char* lpc10_profile_unit(void);
+void lpc10_profile_reset(struct lpc10_profile* prof);
+#endif
 
 #endif /* __LPC10_H__ */
@@ -0,0 +1,248 @@
+/*
+
+ * Batch interface: whole runs of 16-bit samples to and from the bytes
+ * of an LPC-10 stream, for callers that do not want to convert and
+ * pack every frame themselves.
+
+*/
+
+#include "f2c.h"
+
+extern integer synctl_(integer*, integer*, real*, real*, struct lpc10_decoder_state*);
+extern void random_skip_(struct lpc10_decoder_state*, unsigned long long);
+
+/* ***************************************************************** */
+
+/* Pack the 54 bits of one frame into a bit stream, least significant */
+/* bit of each byte first, starting at bit POS of BYTES.  Bits beyond */
+/* the frame in its last byte are cleared. */
+
+static void packfr_(const integer* bits, unsigned char* bytes, integer pos) {
+    integer i__, b;
+
+    bytes += pos >> 3;
+    pos &= 7;
+    if (pos == 0) {
+        *bytes = 0;
+    }
+    for (i__ = 0; i__ < LPC10_BITS_IN_COMPRESSED_FRAME; ++i__) {
+        b = pos + i__;
+        if ((b & 7) == 0 && b > 0) {
+            bytes[b >> 3] = 0;
+        }
+        bytes[b >> 3] |= (unsigned char)((bits[i__] & 1) << (b & 7));
+    }
+} /* packfr_ */
+
+/* The inverse of PACKFR. */
+
+static void unpkfr_(const unsigned char* bytes, integer* bits, integer pos) {
+    integer i__, b;
+
+    bytes += pos >> 3;
+    pos &= 7;
+    for (i__ = 0; i__ < LPC10_BITS_IN_COMPRESSED_FRAME; ++i__) {
+        b = pos + i__;
+        bits[i__] = (bytes[b >> 3] >> (b & 7)) & 1;
+    }
+} /* unpkfr_ */
+
+/* ***************************************************************** */
+
+/* Encode frame F of NSAMPLES 16-bit speech samples, the samples past */
+/* the end read as silence. */
+
+static void encfr_(const INT16* pcm, integer nsamples, integer f, integer* bits, struct lpc10_encoder_state* st) {
+    real speech[LPC10_SAMPLES_PER_FRAME];
+    integer i__, n;
+
+    n = min(max(nsamples - f * LPC10_SAMPLES_PER_FRAME, 0), LPC10_SAMPLES_PER_FRAME);
+    for (i__ = 0; i__ < n; ++i__) {
+        speech[i__] = pcm[f * LPC10_SAMPLES_PER_FRAME + i__] / 32768.f;
+    }
+    for (; i__ < LPC10_SAMPLES_PER_FRAME; ++i__) {
+        speech[i__] = 0.f;
+    }
+    lpc10_encode(speech, bits, st);
+} /* encfr_ */
+
+/* Encode NSAMPLES 16-bit speech samples to the bytes of an LPC-10 */
+/* stream. */
+
+/* Input: */
+/*  PCM      - Speech samples, indices 0 through NSAMPLES-1 read. */
+/*  NSAMPLES - Number of samples.  A last partial frame is completed */
+/*             with silence, as is a last partial block if TIGHT. */
+/*  TIGHT    - If nonzero, the frames are one continuous bit stream, */
+/*             every LPC10_TIGHT_FRAMES frames in LPC10_TIGHT_BYTES */
+/*             bytes; otherwise each frame takes */
+/*             LPC10_BYTES_IN_COMPRESSED_FRAME bytes. */
+/* Output: */
+/*  BYTES    - LPC10_ENCODED_BYTES(NSAMPLES, TIGHT) bytes written. */
+/* Returns the number of bytes written. */
+
+int lpc10_encode_s16(const INT16* pcm, int nsamples, unsigned char* bytes, int tight, struct lpc10_encoder_state* st) {
+    integer bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+    integer f, nframes;
+
+    nframes = (nsamples + LPC10_SAMPLES_PER_FRAME - 1) / LPC10_SAMPLES_PER_FRAME;
+    if (tight) {
+        nframes = (nframes + LPC10_TIGHT_FRAMES - 1) / LPC10_TIGHT_FRAMES * LPC10_TIGHT_FRAMES;
+    }
+    for (f = 0; f < nframes; ++f) {
+        encfr_(pcm, nsamples, f, bits, st);
+        if (tight) {
+            packfr_(bits, bytes, f * LPC10_BITS_IN_COMPRESSED_FRAME);
+        } else {
+            packfr_(bits, bytes + f * LPC10_BYTES_IN_COMPRESSED_FRAME, 0);
+        }
+    }
+    return LPC10_ENCODED_BYTES(nsamples, tight);
+} /* lpc10_encode_s16 */
+
+/* Encode frames FIRST through FIRST+NFRAMES-1 of the stream that */
+/* LPC10_ENCODE_S16 would make of NSAMPLES samples, without encoding */
+/* the frames before them, so that the chunks of a long input can be */
+/* encoded independently (e.g. on several threads) and concatenated. */
+
+/* ST is reinitialized (keeping its lowdelay member) and primed with */
+/* the WARMUP frames before FIRST, whose bits are discarded.  With */
+/* LPC10_CHUNK_WARMUP frames of warm-up, 99.4 to 99.7% of the frames */
+/* came out as in a sequential encoding in our tests; the others */
+/* differ, in runs that can reach 1500 frames past the chunk start */
+/* (see lpc10.h).  Longer warm-ups make them fewer. */
+
+/* Input: */
+/*  PCM      - Speech samples, indices 0 through NSAMPLES-1 read. */
+/*  FIRST    - First frame to encode, a multiple of */
+/*             LPC10_TIGHT_FRAMES if TIGHT. */
+/*  NFRAMES  - Number of frames to encode; with TIGHT, a last partial */
+/*             block is written whole. */
+/*  WARMUP   - Frames to encode before FIRST, as far as there are any. */
+/*  TIGHT    - As for LPC10_ENCODE_S16. */
+/* Output: */
+/*  BYTES    - The bytes of frames FIRST through FIRST+NFRAMES-1. */
+/* Returns the number of bytes written. */
+
+int lpc10_encode_chunk(const INT16* pcm, int nsamples, int first, int nframes, int warmup, unsigned char* bytes, int tight,
+                       struct lpc10_encoder_state* st) {
+    integer bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+    integer f, start, lowdelay;
+
+    lowdelay = st->lowdelay;
+    init_lpc10_encoder_state(st);
+    st->lowdelay = lowdelay;
+
+    /* The sync bit alternates from frame to frame: give the first */
+    /* frame encoded the value it has in the whole stream. */
+    start = max(first - warmup, 0);
+    st->isync = start & 1;
+
+    for (f = start; f < first; ++f) {
+        encfr_(pcm, nsamples, f, bits, st);
+    }
+    if (tight) {
+        nframes = (nframes + LPC10_TIGHT_FRAMES - 1) / LPC10_TIGHT_FRAMES * LPC10_TIGHT_FRAMES;
+    }
+    for (f = 0; f < nframes; ++f) {
+        encfr_(pcm, nsamples, first + f, bits, st);
+        if (tight) {
+            packfr_(bits, bytes, f * LPC10_BITS_IN_COMPRESSED_FRAME);
+        } else {
+            packfr_(bits, bytes + f * LPC10_BYTES_IN_COMPRESSED_FRAME, 0);
+        }
+    }
+    return tight ? nframes / LPC10_TIGHT_FRAMES * LPC10_TIGHT_BYTES : nframes * LPC10_BYTES_IN_COMPRESSED_FRAME;
+} /* lpc10_encode_chunk */
+
+/* Get the bits of frame F of a stream. */
+
+static void getfr_(const unsigned char* bytes, integer f, integer* bits, int tight) {
+    if (tight) {
+        unpkfr_(bytes, bits, f * LPC10_BITS_IN_COMPRESSED_FRAME);
+    } else {
+        unpkfr_(bytes + f * LPC10_BYTES_IN_COMPRESSED_FRAME, bits, 0);
+    }
+} /* getfr_ */
+
+/* Convert N real speech samples to 16-bit samples: scaled by 32768, */
+/* clamped, and truncated toward zero. */
+
+void lpc10_speech_to_s16(const real* speech, INT16* pcm, int n) {
+    real s;
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+        s = speech[i__] * 32768.f;
+        pcm[i__] = s > 32767.f ? 32767 : s < -32768.f ? -32768 : (INT16)s;
+    }
+} /* lpc10_speech_to_s16 */
+
+/* Decode frame F of a stream to 16-bit samples. */
+
+static void decfr_(const unsigned char* bytes, integer f, INT16* pcm, int tight, struct lpc10_decoder_state* st) {
+    real speech[LPC10_SAMPLES_PER_FRAME];
+    integer bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+
+    getfr_(bytes, f, bits, tight);
+    lpc10_decode(bits, speech, st);
+    lpc10_speech_to_s16(speech, pcm, LPC10_SAMPLES_PER_FRAME);
+} /* decfr_ */
+
+/* Decode the whole frames in NBYTES bytes of an LPC-10 stream to */
+/* 16-bit speech samples. */
+
+/* Input: */
+/*  BYTES  - Indices 0 through NBYTES-1 read.  Trailing bytes short of a */
+/*           frame (a block if TIGHT) are ignored. */
+/*  TIGHT  - As for LPC10_ENCODE_S16. */
+/* Output: */
+/*  PCM    - LPC10_DECODED_SAMPLES(NBYTES, TIGHT) samples written. */
+/* Returns the number of samples written. */
+
+int lpc10_decode_s16(const unsigned char* bytes, int nbytes, INT16* pcm, int tight, struct lpc10_decoder_state* st) {
+    integer f, nframes;
+
+    nframes = LPC10_DECODED_SAMPLES(nbytes, tight) / LPC10_SAMPLES_PER_FRAME;
+    for (f = 0; f < nframes; ++f) {
+        decfr_(bytes, f, pcm + f * LPC10_SAMPLES_PER_FRAME, tight, st);
+    }
+    return nframes * LPC10_SAMPLES_PER_FRAME;
+} /* lpc10_decode_s16 */
+
+/* Skip NFRAMES frames of a stream: the decoder state is left as */
+/* decoding them would leave it, without the cost of synthesizing */
+/* them.  The parts of the decoder that decide how frames are */
+/* synthesized, which only depend on the frames decoded, are run; the */
+/* noise generator, the one part of the state that never forgets, is */
+/* advanced past the noise the frames would have drawn; the memory of */
+/* the synthesis filters and the samples buffered for the next frame */
+/* are not updated.  Decoding LPC10_CHUNK_PREROLL more frames settles */
+/* those, after which the samples are the ones the whole stream */
+/* decoded in one piece gives.  Skipping costs a small part of */
+/* decoding, which makes it the sequential part of a decoder that */
+/* decodes the chunks of a long stream in parallel. */
+
+/* Input: */
+/*  BYTES    - Indices 0 through LPC10_ENCODED_BYTES(NFRAMES * */
+/*             LPC10_SAMPLES_PER_FRAME, TIGHT)-1 read. */
+/*  NFRAMES  - Number of frames to skip, a multiple of */
+/*             LPC10_TIGHT_FRAMES if TIGHT. */
+/*  TIGHT    - As for LPC10_ENCODE_S16. */
+/* Input/Output: */
+/*  ST       - The decoder state. */
+
+void lpc10_decode_skip(const unsigned char* bytes, int nframes, int tight, struct lpc10_decoder_state* st) {
+    integer bits[LPC10_BITS_IN_COMPRESSED_FRAME], voice[2];
+    integer f, pitch;
+    real rms, rc[LPC10_ORDER];
+    unsigned long long noise;
+
+    noise = 0;
+    for (f = 0; f < nframes; ++f) {
+        getfr_(bytes, f, bits, tight);
+        lpc10_dequantize(bits, voice, &pitch, &rms, rc, st);
+        noise += synctl_(voice, &pitch, &rms, rc, st);
+    }
+    random_skip_(st, noise);
+} /* lpc10_decode_skip */
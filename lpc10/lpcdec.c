@@ -27,18 +27,9 @@
 extern int lpcdec_(integer* bits, real* speech);
 extern int initlpcdec_(void);
 
-/* Common Block Declarations */
-
-extern struct {
-    integer order, lframe;
-    logical corrp;
-} contrl_;
-
-#define contrl_1 contrl_
-
 /* Table of constant values */
 
-static integer c__10 = 10;
+static const integer c__10 = 10;
 
 /* ***************************************************************** */
 
@@ -77,13 +68,8 @@ static integer c__10 = 10;
 /* INITLPCDEC. */
 
 /* Subroutine */ int lpc10_decode(integer* bits, real* speech, struct lpc10_decoder_state* st) {
-    integer irms, voice[2], pitch, ipitv;
-    extern /* Subroutine */ int decode_(integer*, integer*, integer*, integer*, integer*, real*, real*,
-                                        struct lpc10_decoder_state*);
+    integer voice[2], pitch;
     real rc[10];
-    extern /* Subroutine */ int chanrd_(integer*, integer*, integer*, integer*, integer*),
-        synths_(integer*, integer*, real*, real*, real*, integer*, struct lpc10_decoder_state*);
-    integer irc[10], len;
     real rms;
 
     /*   LPC Configuration parameters: */
@@ -177,8 +163,50 @@ static integer c__10 = 10;
 
     /* Function Body */
 
-    chanrd_(&c__10, &ipitv, &irms, irc, &bits[1]);
-    decode_(&ipitv, &irms, irc, voice, &pitch, &rms, rc, st);
-    synths_(voice, &pitch, &rms, rc, &speech[1], &len, st);
+    lpc10_dequantize(&bits[1], voice, &pitch, &rms, rc, st);
+    lpc10_synthesize(voice, &pitch, &rms, rc, &speech[1], st);
     return 0;
 } /* lpcdec_ */
+
+/* ***************************************************************** */
+
+/* The two halves of LPC10_DECODE, for callers that time them or want */
+/* the parameters themselves. */
+
+/* Decode 54 bits to the parameters of one frame. */
+
+/* Input: */
+/*  BITS   - As for LPC10_DECODE. */
+/* Output: */
+/*  VOICE  - Half-frame voicing decisions, indices 1 and 2 written. */
+/*  PITCH  - Pitch period. */
+/*  RMS    - Energy. */
+/*  RC     - Reflection coefficients, indices 1 through 10 written. */
+/*  These are error corrected and smoothed, and describe the frame */
+/*  passed one call earlier. */
+
+/* Subroutine */ int lpc10_dequantize(integer* bits, integer* voice, integer* pitch, real* rms, real* rc,
+                                      struct lpc10_decoder_state* st) {
+    extern /* Subroutine */ int decode_(integer*, integer*, integer*, integer*, integer*, real*, real*,
+                                        struct lpc10_decoder_state*);
+    extern /* Subroutine */ int chanrd_(const integer*, integer*, integer*, integer*, integer*);
+    integer irms, ipitv, irc[10];
+
+    chanrd_(&c__10, &ipitv, &irms, irc, bits);
+    decode_(&ipitv, &irms, irc, voice, pitch, rms, rc, st);
+    st->nlost = 0;
+    return 0;
+} /* lpc10_dequantize */
+
+/* Synthesize one frame of 180 speech samples from the parameters of a */
+/* frame, as from LPC10_DEQUANTIZE.  VOICE, PITCH, RMS and RC are read */
+/* (PITCH and RC are clamped in place); SPEECH is as for LPC10_DECODE. */
+
+/* Subroutine */ int lpc10_synthesize(integer* voice, integer* pitch, real* rms, real* rc, real* speech,
+                                      struct lpc10_decoder_state* st) {
+    extern /* Subroutine */ int synths_(integer*, integer*, real*, real*, real*, integer*, struct lpc10_decoder_state*);
+    integer len;
+
+    synths_(voice, pitch, rms, rc, speech, &len, st);
+    return 0;
+} /* lpc10_synthesize */
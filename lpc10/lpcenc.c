@@ -30,8 +30,8 @@ extern int initlpcenc_(void);
 
 /* Table of constant values */
 
-static integer c__180 = 180;
-static integer c__10 = 10;
+static const integer c__180 = 180;
+static const integer c__10 = 10;
 
 /* ***************************************************************** */
 
@@ -73,13 +73,8 @@ static integer c__10 = 10;
 /* INITLPCENC. */
 
 /* Subroutine */ int lpc10_encode(real* speech, integer* bits, struct lpc10_encoder_state* st) {
-    integer irms, voice[2], pitch, ipitv;
+    integer voice[2], pitch;
     real rc[10];
-    extern /* Subroutine */ int encode_(integer*, integer*, real*, real*, integer*, integer*, integer*),
-        chanwr_(integer*, integer*, integer*, integer*, integer*, struct lpc10_encoder_state*),
-        analys_(real*, integer*, integer*, real*, real*, struct lpc10_encoder_state*),
-        prepro_(real*, integer*, struct lpc10_encoder_state*);
-    integer irc[10];
     real rms;
 
     /*       Arguments */
@@ -100,9 +95,48 @@ static integer c__10 = 10;
     }
 
     /* Function Body */
-    prepro_(&speech[1], &c__180, st);
-    analys_(&speech[1], voice, &pitch, &rms, rc, st);
-    encode_(voice, &pitch, &rms, rc, &ipitv, &irms, irc);
-    chanwr_(&c__10, &ipitv, &irms, irc, &bits[1], st);
+    lpc10_analyze(&speech[1], voice, &pitch, &rms, rc, st);
+    lpc10_quantize(voice, &pitch, &rms, rc, &bits[1], st);
     return 0;
 } /* lpcenc_ */
+
+/* ***************************************************************** */
+
+/* The two halves of LPC10_ENCODE, for callers that time them or want */
+/* the parameters themselves. */
+
+/* Analyze one frame of 180 speech samples. */
+
+/* Input: */
+/*  SPEECH - As for LPC10_ENCODE. */
+/* Output: */
+/*  VOICE  - Half-frame voicing decisions, indices 1 and 2 written. */
+/*  PITCH  - Pitch period. */
+/*  RMS    - Energy. */
+/*  RC     - Reflection coefficients, indices 1 through 10 written. */
+/*  These describe the frame read LPC10_ENCODER_DELAY calls earlier. */
+
+/* Subroutine */ int lpc10_analyze(real* speech, integer* voice, integer* pitch, real* rms, real* rc,
+                                   struct lpc10_encoder_state* st) {
+    extern /* Subroutine */ int analys_(real*, integer*, integer*, real*, real*, struct lpc10_encoder_state*),
+        prepro_(real*, const integer*, struct lpc10_encoder_state*);
+
+    prepro_(speech, &c__180, st);
+    analys_(speech, voice, pitch, rms, rc, st);
+    return 0;
+} /* lpc10_analyze */
+
+/* Quantize the parameters of one frame, as from LPC10_ANALYZE, to 54 */
+/* bits.  VOICE, PITCH, RMS and RC are read; BITS is as for */
+/* LPC10_ENCODE. */
+
+/* Subroutine */ int lpc10_quantize(integer* voice, integer* pitch, real* rms, real* rc, integer* bits,
+                                    struct lpc10_encoder_state* st) {
+    extern /* Subroutine */ int encode_(integer*, integer*, real*, real*, integer*, integer*, integer*),
+        chanwr_(const integer*, integer*, integer*, integer*, integer*, struct lpc10_encoder_state*);
+    integer irms, ipitv, irc[10];
+
+    encode_(voice, pitch, rms, rc, &ipitv, &irms, irc);
+    chanwr_(&c__10, &ipitv, &irms, irc, bits, st);
+    return 0;
+} /* lpc10_quantize */
@@ -0,0 +1,230 @@
+/*
+
+ * The LPC-10 file format: a stream laid out for seeking, with the
+ * decoder state at regular points so that decoding can start at any
+ * of them and give the samples the whole file decoded gives.
+
+*/
+
+#include <string.h>
+
+#include "f2c.h"
+
+/* A file is a header, then sync points each followed by the frames */
+/* up to the next, and last an index of the sync points.  Numbers are */
+/* unsigned and least significant byte first. */
+
+/* Header, LPC10_FILE_HEADER_BYTES: */
+/*   0  8  "#!LPC10\n" */
+/*   8  1  LPC10_FILE_VERSION */
+/*   9  1  packing: 0 for 7-byte frames, 1 for tight */
+/*  10  2  0 */
+/*  12  4  sample rate, 8000 */
+/*  16  8  frames in the file, all ones if not known */
+/*  24  8  offset of the index, 0 if there is none */
+
+/* Sync point, LPC10_FILE_SYNC_HEAD bytes and the decoder state: */
+/*   0  4  "LSYN" */
+/*   4  8  number of the frame after it */
+/*  12  4  frames after it up to the next sync point or the index, */
+/*         a multiple of LPC10_TIGHT_FRAMES with tight packing */
+/*  16  2  bytes of decoder state */
+/*  18     the decoder state before that frame, as */
+/*         lpc10_decoder_state_save writes it */
+
+/* Index, LPC10_FILE_INDEX_BYTES(count): */
+/*   0  4  "LIDX" */
+/*   4  4  count */
+/*   8     per sync point, 8 bytes frame number and 8 bytes offset */
+
+static void put_(unsigned char* bytes, unsigned long long v, integer n) {
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+        bytes[i__] = (unsigned char)(v >> (i__ << 3));
+    }
+} /* put_ */
+
+static unsigned long long get_(const unsigned char* bytes, integer n) {
+    unsigned long long v;
+    integer i__;
+
+    v = 0;
+    for (i__ = n - 1; i__ >= 0; --i__) {
+        v = v << 8 | bytes[i__];
+    }
+    return v;
+} /* get_ */
+
+/* ***************************************************************** */
+
+/* Write the header of a file.  Returns LPC10_FILE_HEADER_BYTES. */
+
+/* Input: */
+/*  H     - The header; NFRAMES -1 if not known yet. */
+/* Output: */
+/*  BYTES - LPC10_FILE_HEADER_BYTES bytes written. */
+
+int lpc10_file_header_write(const struct lpc10_file_header* h, unsigned char* bytes) {
+    memcpy(bytes, "#!LPC10\n", 8);
+    bytes[8] = LPC10_FILE_VERSION;
+    bytes[9] = h->tight != 0;
+    put_(bytes + 10, 0, 2);
+    put_(bytes + 12, (unsigned long long)h->rate, 4);
+    put_(bytes + 16, (unsigned long long)h->nframes, 8);
+    put_(bytes + 24, (unsigned long long)h->index, 8);
+    return LPC10_FILE_HEADER_BYTES;
+} /* lpc10_file_header_write */
+
+/* Read the header of a file from the first NBYTES bytes of it. */
+/* Returns LPC10_FILE_HEADER_BYTES; 0 if NBYTES is less; or -1 if the */
+/* bytes are not the header of a file of LPC10_FILE_VERSION. */
+
+int lpc10_file_header_read(struct lpc10_file_header* h, const unsigned char* bytes, int nbytes) {
+    unsigned long long nframes, index;
+
+    if (nbytes < 8) {
+        return memcmp(bytes, "#!LPC10\n", nbytes) == 0 ? 0 : -1;
+    }
+    if (memcmp(bytes, "#!LPC10\n", 8) != 0) {
+        return -1;
+    }
+    if (nbytes < LPC10_FILE_HEADER_BYTES) {
+        return 0;
+    }
+    nframes = get_(bytes + 16, 8);
+    index = get_(bytes + 24, 8);
+    if (bytes[8] != LPC10_FILE_VERSION || bytes[9] > 1 || get_(bytes + 12, 4) == 0 ||
+        (nframes > (1ULL << 62) && nframes != ~0ULL) || index > (1ULL << 62)) {
+        return -1;
+    }
+    h->tight = bytes[9];
+    h->rate = (int)get_(bytes + 12, 4);
+    h->nframes = nframes == ~0ULL ? -1 : (long long)nframes;
+    h->index = (long long)index;
+    return LPC10_FILE_HEADER_BYTES;
+} /* lpc10_file_header_read */
+
+/* ***************************************************************** */
+
+/* Write a sync point.  Returns the number of bytes written, at most */
+/* LPC10_FILE_SYNC_BYTES. */
+
+/* Input: */
+/*  FRAME   - Number of the frame after it. */
+/*  NFRAMES - Frames after it up to the next sync point. */
+/*  ST      - The decoder state once the frames before FRAME have */
+/*            been decoded. */
+
+int lpc10_file_sync_write(long long frame, int nframes, const struct lpc10_decoder_state* st, unsigned char* bytes) {
+    integer n;
+
+    n = lpc10_decoder_state_save(st, bytes + LPC10_FILE_SYNC_HEAD);
+    memcpy(bytes, "LSYN", 4);
+    put_(bytes + 4, (unsigned long long)frame, 8);
+    put_(bytes + 12, (unsigned long long)nframes, 4);
+    put_(bytes + 16, (unsigned long long)n, 2);
+    return LPC10_FILE_SYNC_HEAD + n;
+} /* lpc10_file_sync_write */
+
+/* The size of the sync point that starts BYTES, from its first */
+/* LPC10_FILE_SYNC_HEAD bytes.  Returns 0 if NBYTES is less, or -1 if */
+/* the bytes do not start a sync point. */
+
+int lpc10_file_sync_bytes(const unsigned char* bytes, int nbytes) {
+    integer n;
+
+    if (memcmp(bytes, "LSYN", min(nbytes, 4)) != 0) {
+        return -1;
+    }
+    if (nbytes < LPC10_FILE_SYNC_HEAD) {
+        return 0;
+    }
+    n = (integer)get_(bytes + 16, 2);
+    if (n > LPC10_DECODER_STATE_BYTES) {
+        return -1;
+    }
+    return LPC10_FILE_SYNC_HEAD + n;
+} /* lpc10_file_sync_bytes */
+
+/* Read the sync point that starts the NBYTES bytes at BYTES.  Returns */
+/* its size; 0 if NBYTES is less; or -1 if the bytes are not a sync */
+/* point, its decoder state included. */
+
+/* Output: */
+/*  FRAME   - Number of the frame after it. */
+/*  NFRAMES - Frames after it up to the next sync point. */
+/*  ST      - If not null, the decoder state restored. */
+
+int lpc10_file_sync_read(long long* frame, int* nframes, struct lpc10_decoder_state* st, const unsigned char* bytes,
+                         int nbytes) {
+    struct lpc10_decoder_state s;
+    unsigned long long f, n;
+    integer size;
+
+    size = lpc10_file_sync_bytes(bytes, nbytes);
+    if (size <= 0 || nbytes < size) {
+        return size < 0 ? -1 : 0;
+    }
+    f = get_(bytes + 4, 8);
+    n = get_(bytes + 12, 4);
+    if (f > (1ULL << 62) || n > 0x7fffffffULL) {
+        return -1;
+    }
+    if (!st) {
+        st = &s;
+    }
+    if (lpc10_decoder_state_restore(st, bytes + LPC10_FILE_SYNC_HEAD, size - LPC10_FILE_SYNC_HEAD) !=
+        size - LPC10_FILE_SYNC_HEAD) {
+        return -1;
+    }
+    *frame = (long long)f;
+    *nframes = (int)n;
+    return size;
+} /* lpc10_file_sync_read */
+
+/* ***************************************************************** */
+
+/* Write the index of COUNT sync points.  Returns */
+/* LPC10_FILE_INDEX_BYTES(COUNT). */
+
+int lpc10_file_index_write(const struct lpc10_file_sync* syncs, int count, unsigned char* bytes) {
+    integer i__;
+
+    memcpy(bytes, "LIDX", 4);
+    put_(bytes + 4, (unsigned long long)count, 4);
+    for (i__ = 0; i__ < count; ++i__) {
+        put_(bytes + 8 + (i__ << 4), (unsigned long long)syncs[i__].frame, 8);
+        put_(bytes + 16 + (i__ << 4), (unsigned long long)syncs[i__].offset, 8);
+    }
+    return LPC10_FILE_INDEX_BYTES(count);
+} /* lpc10_file_index_write */
+
+/* Read the first MAX entries of the index in the NBYTES bytes at */
+/* BYTES.  Returns the number of entries in the index, which may be */
+/* more than MAX (MAX 0 only reads the count); or -1 if the bytes are */
+/* not an index or stop short of the entries to read. */
+
+int lpc10_file_index_read(struct lpc10_file_sync* syncs, int max, const unsigned char* bytes, int nbytes) {
+    unsigned long long count;
+    integer i__;
+
+    if (nbytes < LPC10_FILE_INDEX_BYTES(0) || memcmp(bytes, "LIDX", 4) != 0) {
+        return -1;
+    }
+    count = get_(bytes + 4, 4);
+    if (count > 0x7fffffffULL / 16) {
+        return -1;
+    }
+    if ((unsigned long long)max > count) {
+        max = (int)count;
+    }
+    if (nbytes < LPC10_FILE_INDEX_BYTES(max)) {
+        return -1;
+    }
+    for (i__ = 0; i__ < max; ++i__) {
+        syncs[i__].frame = (long long)(get_(bytes + 8 + (i__ << 4), 8) & ((1ULL << 62) - 1));
+        syncs[i__].offset = (long long)(get_(bytes + 16 + (i__ << 4), 8) & ((1ULL << 62) - 1));
+    }
+    return (int)count;
+} /* lpc10_file_index_read */
@@ -18,13 +18,13 @@
 #include <stdlib.h>
 
 #include "f2c.h"
+#include "lpcprof.h"
 
 extern int lpcini_(void);
 
 /* Common Block Declarations */
 
 struct {
-    integer order, lframe;
     logical corrp;
 } contrl_;
 
@@ -121,8 +121,8 @@ struct {
     /*      common /contrl/ fsi, fso, fpi, fpo, fbi, fbo, pbin, fmsg, fdebug */
     /*      common /contrl/ quant, nbits */
     /*      common /contrl/ nframe, nunsfm, iclip, maxosp, listl, lincnt */
-    contrl_1.order = 10;
-    contrl_1.lframe = 180;
+    /* order and lframe are the compile-time constants LPC10_ORDER and */
+    /* LPC10_LFRAME from lpc10.h. */
     contrl_1.corrp = TRUE_;
     return 0;
 } /* lpcini_ */
@@ -184,11 +184,12 @@ void init_lpc10_encoder_state(struct lpc10_encoder_state* st) {
         st->rcbuf[i] = 0.0f;
     }
     st->zpre = 0.0f;
+    st->lowdelay = FALSE_;
 
     /* State used by function onset */
     st->n = 0.0f;
     st->d__ = 1.0f;
-    /* real fpc;    no initial value necessary */
+    st->fpc = 0.0f;
     for (i = 0; i < 16; i++) {
         st->l2buf[i] = 0.0f;
     }
@@ -223,9 +224,14 @@ void init_lpc10_encoder_state(struct lpc10_encoder_state* st) {
     }
     st->ipoint = 0;
     st->alphax = 0.0f;
+    st->minsc = 0.0f;
 
     /* State used by function chanwr */
     st->isync = 0;
+
+#ifdef LPC10_PROFILE
+    lpc10_profile_reset(&st->prof);
+#endif
 }
 
 /* Allocate memory for, and initialize, the state that needs to be
@@ -262,12 +268,18 @@ void init_lpc10_decoder_state(struct lpc10_decoder_state* st) {
         st->dpit[i] = 0;
         st->drms[i] = 0;
     }
+    st->hamfix = 0;
+    st->hambad = 0;
 
     /* State used by function synths */
     for (i = 0; i < 360; i++) {
         st->buf[i] = 0.0f;
     }
     st->buflen = 180;
+    st->silent = FALSE_;
+
+    /* State used by function lpc10_conceal */
+    st->nlost = 0;
 
     /* State used by function pitsyn */
     /* ivoico;    no initial value necessary as long as first_pitsyn is initially TRUE_ */
@@ -306,4 +318,42 @@ void init_lpc10_decoder_state(struct lpc10_decoder_state* st) {
     st->deo1 = 0.0f;
     st->deo2 = 0.0f;
     st->deo3 = 0.0f;
+
+#ifdef LPC10_PROFILE
+    lpc10_profile_reset(&st->prof);
+#endif
+}
+
+#ifdef LPC10_PROFILE
+
+/* Return the name of a stage of enum lpc10_profile_stage, or 0 if */
+/* there is no such stage. */
+
+const char* lpc10_profile_name(int stage) {
+    static const char* const names[LPC10_PROF_STAGES] = {"lpfilt", "ivfilt", "tbdm",   "voicin", "dyptrk", "place",
+                                                         "mload",  "invert", "pitsyn", "irc2pc", "bsynz",  "deemp"};
+
+    if (stage < 0 || stage >= LPC10_PROF_STAGES) {
+        return 0;
+    }
+    return names[stage];
 }
+
+/* Return the unit the ticks of struct lpc10_profile are counted in. */
+
+const char* lpc10_profile_unit(void) {
+    return LPC10_PROF_UNIT;
+}
+
+/* Zero the counters, e.g. to leave out a warm-up. */
+
+void lpc10_profile_reset(struct lpc10_profile* prof) {
+    int i;
+
+    for (i = 0; i < LPC10_PROF_STAGES; i++) {
+        prof->ticks[i] = 0;
+        prof->calls[i] = 0;
+    }
+}
+
+#endif /* LPC10_PROFILE */
@@ -0,0 +1,101 @@
+/*
+
+ * Packet loss concealment for the LPC-10 decoder.
+
+*/
+
+#include "f2c.h"
+
+/* Per lost frame attenuation of RMS, about -3 dB per 22.5 ms frame. */
+
+#define PLCATT .7f
+
+/* After this many consecutive lost frames, voiced frames are */
+/* continued as unvoiced, so that a long loss fades out as noise */
+/* instead of a buzz at the last pitch. */
+
+#define PLCUV 3
+
+/* Frames that were unvoiced with an RMS at or below this level are */
+/* taken to be background noise (e.g. the silence descriptor frames */
+/* of an encoder using DTX), and are continued without attenuation. */
+
+#define PLCSIL 7.f
+
+/* ***************************************************************** */
+
+/* Synthesize one frame of 180 speech samples in place of a frame */
+/* that was lost. */
+
+/* The parameters of the last decoded frame are extrapolated: PITSYN */
+/* keeps the voicing (IVOICO), pitch (IPITO), RMS (RMSO) and */
+/* reflection coefficients (RCO) it last synthesized, after the */
+/* smoothing done by DECODE, and these are handed to SYNTHS again */
+/* with the RMS attenuated by PLCATT for every lost frame.  The */
+/* quantized parameter history of DECODE (DRC, DPIT, DRMS) is advanced */
+/* as if the last received frame had been received again, so that the */
+/* median smoothing of the first good frame after the loss compares */
+/* against the last good frame rather than against older ones. */
+
+/* DECODE holds each frame back one frame for that smoothing, so the */
+/* last frame received before the loss has not been synthesized yet. */
+/* It is not synthesized here, but by the call that decodes the first */
+/* good frame after the loss: around a loss the output is reordered */
+/* by one frame, the concealed frames coming before the last received */
+/* one instead of after it. */
+
+/* Output: */
+/*  SPEECH - Speech encoded as real values in the range [-1,+1]. */
+/*           Indices 1 through 180 written. */
+
+/* Subroutine */ int lpc10_conceal(real* speech, struct lpc10_decoder_state* st) {
+    integer voice[2], pitch, len, i__;
+    real rms, rc[10];
+    extern /* Subroutine */ int synths_(integer*, integer*, real*, real*, real*, integer*, struct lpc10_decoder_state*);
+
+    /* Parameter adjustments */
+    if (speech) {
+        --speech;
+    }
+
+    /* Function Body */
+    /* Counted up to PLCUV+1 only, which is all that is tested, so that */
+    /* a long loss cannot overflow it */
+    if (st->nlost <= PLCUV) {
+        ++st->nlost;
+    }
+    if (st->first_pitsyn) {
+        /* Nothing decoded yet: SYNTHS returns silence on its first call */
+        voice[0] = 0;
+        voice[1] = 0;
+        pitch = LPC10_LFRAME / 4;
+        rms = 1.f;
+        for (i__ = 0; i__ < LPC10_ORDER; ++i__) {
+            rc[i__] = 0.f;
+        }
+    } else {
+        voice[0] = st->ivoico;
+        voice[1] = st->ivoico;
+        if (st->nlost > PLCUV) {
+            voice[0] = 0;
+            voice[1] = 0;
+        }
+        pitch = st->ipito;
+        rms = st->rmso;
+        if (st->ivoico != 0 || rms > PLCSIL) {
+            rms *= PLCATT;
+        }
+        for (i__ = 0; i__ < LPC10_ORDER; ++i__) {
+            rc[i__] = st->rco[i__];
+        }
+    }
+
+    st->dpit[2] = st->dpit[1];
+    st->drms[2] = st->drms[1];
+    for (i__ = 1; i__ <= LPC10_ORDER; ++i__) {
+        st->drc[i__ * 3 - 1] = st->drc[i__ * 3 - 2];
+    }
+
+    synths_(voice, &pitch, &rms, rc, &speech[1], &len, st);
+    return 0;
+} /* lpc10_conceal */
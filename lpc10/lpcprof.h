@@ -0,0 +1,46 @@
+/*
+
+ * Stage timers for builds with LPC10_PROFILE defined; see lpc10.h.
+
+*/
+
+#ifndef __LPCPROF_H__
+#define __LPCPROF_H__
+
+#ifdef LPC10_PROFILE
+
+/* The builtin rather than <x86intrin.h>, which pulls in <stdlib.h> and */
+/* clashes with the abs() macro of f2c.h. */
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define LPC10_PROF_UNIT "cycles"
+#define lpc10_prof_now() ((unsigned long long)__builtin_ia32_rdtsc())
+#else
+#include <time.h>
+#define LPC10_PROF_UNIT "ns"
+static inline unsigned long long lpc10_prof_now(void) {
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+#endif
+
+/* LPC10_PROF_DECL goes with the local variables of a routine that times */
+/* its stages; each stage is then bracketed by LPC10_PROF_START() and */
+/* LPC10_PROF_STOP(st, stage). */
+
+#define LPC10_PROF_DECL unsigned long long lpc10_prof_t0;
+#define LPC10_PROF_START() (lpc10_prof_t0 = lpc10_prof_now())
+#define LPC10_PROF_STOP(st, stage) \
+    ((st)->prof.ticks[stage] += lpc10_prof_now() - lpc10_prof_t0, ++(st)->prof.calls[stage])
+
+#else
+
+#define LPC10_PROF_DECL
+#define LPC10_PROF_START() ((void)0)
+#define LPC10_PROF_STOP(st, stage) ((void)0)
+
+#endif /* LPC10_PROFILE */
+
+#endif /* __LPCPROF_H__ */
@@ -0,0 +1,529 @@
+/*
+
+ * Saving and restoring encoder and decoder states, so that a stream
+ * can be carried on in another process or from a checkpoint.
+
+*/
+
+#include <string.h>
+
+#include "f2c.h"
+
+/* A state is saved as a tag, LPC10_STATE_VERSION, and the members in */
+/* the order of their declaration: integers as zigzag varints, reals */
+/* as IEEE singles and INT16s as 2 bytes, least significant first, */
+/* logicals as a byte.  Parts that hold nothing yet, or nothing any */
+/* more (the onset buffer beyond OSPTR, the samples beyond BUFLEN, the */
+/* PITSYN state before its first frame...), are left out, so that a */
+/* state saves compactly and the same way whatever was in them.  The */
+/* profile counters of an LPC10_PROFILE build are not part of it. */
+
+/* A state being saved (IN is 0) or restored, and the bytes so far. */
+
+typedef struct {
+    unsigned char* out;
+    const unsigned char* in;
+    const unsigned char* end;
+    int bad; /* Restoring ran past END */
+} stbuf;
+
+static void xbyte_(stbuf* b, unsigned char* v) {
+    if (!b->in) {
+        *b->out++ = *v;
+    } else if (b->in < b->end) {
+        *v = *b->in++;
+    } else {
+        b->bad = 1;
+    }
+} /* xbyte_ */
+
+static void xint_(stbuf* b, integer* v) {
+    unsigned long u;
+    unsigned char c;
+    int shift;
+
+    if (!b->in) {
+        u = *v < 0 ? ((unsigned long)~*v << 1) | 1 : (unsigned long)*v << 1;
+        do {
+            c = (unsigned char)(u & 0x7f);
+            u >>= 7;
+            if (u != 0) {
+                c |= 0x80;
+            }
+            xbyte_(b, &c);
+        } while (u != 0);
+        return;
+    }
+    u = 0;
+    c = 0;
+    for (shift = 0; shift < 35; shift += 7) {
+        xbyte_(b, &c);
+        u |= (unsigned long)(c & 0x7f) << shift;
+        if (!(c & 0x80)) {
+            break;
+        }
+    }
+    if (shift >= 35 || u > 0xffffffffUL) {
+        b->bad = 1;
+        return;
+    }
+    *v = u & 1 ? (integer) ~(u >> 1) : (integer)(u >> 1);
+} /* xint_ */
+
+static void xints_(stbuf* b, integer* v, integer n) {
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+        xint_(b, &v[i__]);
+    }
+} /* xints_ */
+
+static void xreals_(stbuf* b, real* v, integer n) {
+    unsigned char c[4];
+    unsigned long u;
+    INT32 w;
+    integer i__, k;
+
+    for (i__ = 0; i__ < n; ++i__) {
+        memcpy(&w, &v[i__], 4);
+        u = (unsigned long)w & 0xffffffffUL;
+        for (k = 0; k < 4; ++k) {
+            c[k] = (unsigned char)(u >> (k << 3));
+            xbyte_(b, &c[k]);
+        }
+        if (b->in) {
+            u = c[0] | (unsigned long)c[1] << 8 | (unsigned long)c[2] << 16 | (unsigned long)c[3] << 24;
+            w = u > 0x7fffffffUL ? -(INT32)(0xffffffffUL - u) - 1 : (INT32)u;
+            memcpy(&v[i__], &w, 4);
+        }
+    }
+} /* xreals_ */
+
+static void xshorts_(stbuf* b, shortint* v, integer n) {
+    unsigned char c[2];
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+        c[0] = (unsigned char)(v[i__] & 0xff);
+        c[1] = (unsigned char)((v[i__] >> 8) & 0xff);
+        xbyte_(b, &c[0]);
+        xbyte_(b, &c[1]);
+        if (b->in) {
+            v[i__] = (shortint)(c[1] & 0x80 ? (c[0] | c[1] << 8) - 0x10000 : c[0] | c[1] << 8);
+        }
+    }
+} /* xshorts_ */
+
+static void xlog_(stbuf* b, logical* v) {
+    unsigned char c;
+
+    c = *v != 0;
+    xbyte_(b, &c);
+    if (b->in) {
+        *v = c != 0;
+    }
+} /* xlog_ */
+
+/* The tag: the encoder's or decoder's, then the format version. */
+
+static void xtag_(stbuf* b, char kind) {
+    unsigned char tag[4] = {'L', 'P', 'C', (unsigned char)kind}, c;
+    integer i__;
+
+    for (i__ = 0; i__ < 4; ++i__) {
+        c = tag[i__];
+        xbyte_(b, &c);
+        b->bad |= c != tag[i__];
+    }
+    c = LPC10_STATE_VERSION;
+    xbyte_(b, &c);
+    b->bad |= c != LPC10_STATE_VERSION;
+} /* xtag_ */
+
+/* ***************************************************************** */
+
+static void xenc_(stbuf* b, struct lpc10_encoder_state* st) {
+    integer n;
+
+    xtag_(b, 'E');
+
+    /* hp100 */
+    xreals_(b, &st->z11, 1);
+    xreals_(b, &st->z21, 1);
+    xreals_(b, &st->z12, 1);
+    xreals_(b, &st->z22, 1);
+
+    /* analys; the onsets in OSBUF are the first OSPTR-1 */
+    xreals_(b, st->inbuf, 540);
+    xreals_(b, st->pebuf, 540);
+    xreals_(b, st->lpbuf, 696);
+    xreals_(b, st->ivbuf, 312);
+    xreals_(b, &st->bias, 1);
+    xint_(b, &st->osptr);
+    if (b->bad || st->osptr < 1 || st->osptr > 11) {
+        b->bad = 1;
+        return;
+    }
+    xints_(b, st->osbuf, st->osptr - 1);
+    xints_(b, st->obound, 3);
+    xints_(b, st->vwin, 6);
+    xints_(b, st->awin, 6);
+    xints_(b, st->voibuf, 8);
+    xreals_(b, st->rmsbuf, 3);
+    xreals_(b, st->rcbuf, 30);
+    xreals_(b, &st->zpre, 1);
+    xlog_(b, &st->lowdelay);
+
+    /* onset; LASTI only means something while HYST is set */
+    xreals_(b, &st->n, 1);
+    xreals_(b, &st->d__, 1);
+    xreals_(b, &st->fpc, 1);
+    xreals_(b, st->l2buf, 16);
+    xreals_(b, &st->l2sum1, 1);
+    xint_(b, &st->l2ptr1);
+    xint_(b, &st->l2ptr2);
+    xlog_(b, &st->hyst);
+    n = 0;
+    xint_(b, st->hyst ? &st->lasti : &n);
+
+    /* voicin */
+    xreals_(b, &st->dither, 1);
+    xreals_(b, &st->snr, 1);
+    xreals_(b, &st->maxmin, 1);
+    xreals_(b, st->voice, 6);
+    xint_(b, &st->lbve);
+    xint_(b, &st->lbue);
+    xint_(b, &st->fbve);
+    xint_(b, &st->fbue);
+    xint_(b, &st->ofbue);
+    xint_(b, &st->sfbue);
+    xint_(b, &st->olbue);
+    xint_(b, &st->slbue);
+
+    /* dyptrk */
+    xreals_(b, st->s, 60);
+    xints_(b, st->p, 120);
+    xint_(b, &st->ipoint);
+    xreals_(b, &st->alphax, 1);
+    xreals_(b, &st->minsc, 1);
+
+    /* chanwr */
+    xint_(b, &st->isync);
+} /* xenc_ */
+
+static void xdec_(stbuf* b, struct lpc10_decoder_state* st) {
+    integer i__;
+
+    xtag_(b, 'D');
+
+    /* decode */
+    xint_(b, &st->iptold);
+    xlog_(b, &st->first);
+    xint_(b, &st->ivp2h);
+    xint_(b, &st->iovoic);
+    xint_(b, &st->iavgp);
+    xint_(b, &st->erate);
+    xints_(b, st->drc, 30);
+    xints_(b, st->dpit, 3);
+    xints_(b, st->drms, 3);
+    xint_(b, &st->hamfix);
+    xint_(b, &st->hambad);
+
+    /* synths; the samples in BUF are the first BUFLEN */
+    xint_(b, &st->buflen);
+    if (b->bad || st->buflen < 0 || st->buflen > LPC10_SAMPLES_PER_FRAME) {
+        b->bad = 1;
+        return;
+    }
+    xreals_(b, st->buf, st->buflen);
+    xlog_(b, &st->silent);
+
+    /* lpc10_conceal */
+    xint_(b, &st->nlost);
+
+    /* pitsyn, from its first frame on */
+    xlog_(b, &st->first_pitsyn);
+    xreals_(b, &st->rmso, 1);
+    if (!st->first_pitsyn) {
+        xint_(b, &st->ivoico);
+        xint_(b, &st->ipito);
+        xreals_(b, st->rco, 10);
+        xint_(b, &st->jsamp);
+    }
+
+    /* bsynz: the filter history is the first ORDER samples of EXC and */
+    /* EXC2, which BSYNZ also leaves at EXC2(IPO+1) */
+    xint_(b, &st->ipo);
+    if (b->bad || st->ipo < 0 || st->ipo > 156) {
+        b->bad = 1;
+        return;
+    }
+    xreals_(b, st->exc, LPC10_ORDER);
+    xreals_(b, st->exc2, LPC10_ORDER);
+    if (b->in) {
+        for (i__ = 0; i__ < LPC10_ORDER; ++i__) {
+            st->exc2[st->ipo + i__] = st->exc2[i__];
+        }
+    }
+    xreals_(b, &st->lpi1, 1);
+    xreals_(b, &st->lpi2, 1);
+    xreals_(b, &st->lpi3, 1);
+    xreals_(b, &st->hpi1, 1);
+    xreals_(b, &st->hpi2, 1);
+    xreals_(b, &st->hpi3, 1);
+    xreals_(b, &st->rmso_bsynz, 1);
+
+    /* random */
+    xint_(b, &st->j);
+    xint_(b, &st->k);
+    xshorts_(b, st->y, 5);
+
+    /* deemp */
+    xreals_(b, &st->dei1, 1);
+    xreals_(b, &st->dei2, 1);
+    xreals_(b, &st->deo1, 1);
+    xreals_(b, &st->deo2, 1);
+    xreals_(b, &st->deo3, 1);
+} /* xdec_ */
+
+/* ***************************************************************** */
+
+/* What a restored state is checked against: a state that was not */
+/* saved, or was damaged since, must not make the encoder or decoder */
+/* index out of their arrays, overflow an integer or convert a real */
+/* out of range, so every member is held to the values the codec */
+/* itself leaves in it.  Reals that are only compared and summed are */
+/* held to REALMAX, far above any value they reach; those that end up */
+/* in integers or samples, closer to what the codec gives them. */
+
+#define REALMAX 1e20f
+
+/* Samples in the encoder's filters and buffers: speech in [-1,+1] is */
+/* scaled to +-4096, and the RMS of a window of them and sums of up */
+/* to 156 of them are converted to integers. */
+
+#define SAMPMAX 1e5f
+
+/* The decoder's synthesis filters and buffer: at most some 10^6 from */
+/* any stream, while from 10^11 on they can overflow within a frame. */
+
+#define SYNMAX 1e9f
+
+/* The most unvoiced or voiced energy VPARMS returns. */
+
+#define EMAX 32767
+
+/* Bits of the codes of RC(1) to RC(10) in a frame, which are signed. */
+
+static const integer rcbits[10] = {5, 5, 5, 5, 4, 4, 4, 4, 3, 2};
+
+/* TRUE_ if the N integers at V are in LO to HI. */
+
+static logical okints_(const integer* v, integer n, integer lo, integer hi) {
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+        if (v[i__] < lo || v[i__] > hi) {
+            return FALSE_;
+        }
+    }
+    return TRUE_;
+} /* okints_ */
+
+/* TRUE_ if the N reals at V are in LO to HI, which NaNs are not. */
+
+static logical okreals_(const real* v, integer n, real lo, real hi) {
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+        if (!(v[i__] >= lo && v[i__] <= hi)) {
+            return FALSE_;
+        }
+    }
+    return TRUE_;
+} /* okreals_ */
+
+/* TRUE_ if the window WIN(1..2) of the current frame is as PLACEV or */
+/* PLACEA leave it, within the last two frames of the buffers. */
+
+static logical okwin_(const integer* win) {
+    return win[0] > LPC10_LFRAME && win[0] <= win[1] && win[1] <= LPC10_LFRAME * 3;
+} /* okwin_ */
+
+/* TRUE_ if the encoder state S can be carried on from. */
+
+static logical okenc_(const struct lpc10_encoder_state* s) {
+    /* hp100 and analys.  OSBUF holds onsets ONSET found in the last */
+    /* frame, at most 9 samples before its end, and the frames before; */
+    /* only the current frame's windows are read again. */
+    if (!okreals_(&s->z11, 1, -SAMPMAX, SAMPMAX) || !okreals_(&s->z21, 1, -SAMPMAX, SAMPMAX) ||
+        !okreals_(&s->z12, 1, -SAMPMAX, SAMPMAX) || !okreals_(&s->z22, 1, -SAMPMAX, SAMPMAX) ||
+        !okreals_(s->inbuf, 540, -SAMPMAX, SAMPMAX) || !okreals_(s->pebuf, 540, -SAMPMAX, SAMPMAX) ||
+        !okreals_(s->lpbuf, 696, -SAMPMAX, SAMPMAX) || !okreals_(s->ivbuf, 312, -SAMPMAX, SAMPMAX) ||
+        !okreals_(&s->bias, 1, -SAMPMAX, SAMPMAX)) {
+        return FALSE_;
+    }
+    if (!okints_(s->osbuf, s->osptr - 1, 1, LPC10_LFRAME * 4 - 9) || !okints_(s->obound, 3, 0, 3) ||
+        !okwin_(&s->vwin[4]) || !okwin_(&s->awin[4]) || !okints_(s->voibuf, 8, 0, 1)) {
+        return FALSE_;
+    }
+    /* INVERT limits the reflection coefficients to .999 */
+    if (!okreals_(s->rmsbuf, 3, 0.f, SAMPMAX) || !okreals_(s->rcbuf, 30, -.999f, .999f) ||
+        !okreals_(&s->zpre, 1, -SAMPMAX, SAMPMAX)) {
+        return FALSE_;
+    }
+
+    /* onset: L2PTR2 runs 8 places ahead of L2PTR1, and LASTI is at */
+    /* most 9 samples before the end of the buffer while HYST is set */
+    if (!okreals_(&s->n, 1, -REALMAX, REALMAX) || !okreals_(&s->d__, 1, -REALMAX, REALMAX) ||
+        !okreals_(&s->fpc, 1, -1.f, 1.f) || !okreals_(s->l2buf, 16, -REALMAX, REALMAX) ||
+        !okreals_(&s->l2sum1, 1, -REALMAX, REALMAX)) {
+        return FALSE_;
+    }
+    if (s->l2ptr1 < 1 || s->l2ptr1 > 16 || s->l2ptr2 != (s->l2ptr1 + 7) % 16 + 1) {
+        return FALSE_;
+    }
+    if (s->hyst && (s->lasti < LPC10_LFRAME * 4 - 9 || s->lasti > LPC10_LFRAME * 4)) {
+        return FALSE_;
+    }
+
+    /* voicin: the energies are averages of those VPARMS returns, */
+    /* SFBUE and SLBUE 8 times them, and SNR 64 times their ratio */
+    if (!okreals_(&s->dither, 1, 1.f, 20.f) || !okreals_(&s->snr, 1, 0.f, EMAX * 64.f) ||
+        !okreals_(&s->maxmin, 1, -REALMAX, REALMAX) || !okreals_(s->voice, 6, -REALMAX, REALMAX)) {
+        return FALSE_;
+    }
+    if (s->lbve < 0 || s->lbve > EMAX || s->lbue < 0 || s->lbue > EMAX || s->fbve < 0 || s->fbve > EMAX ||
+        s->fbue < 0 || s->fbue > EMAX || s->ofbue < 0 || s->ofbue > EMAX || s->olbue < 0 || s->olbue > EMAX ||
+        s->sfbue < 0 || s->sfbue > EMAX * 8 || s->slbue < 0 || s->slbue > EMAX * 8) {
+        return FALSE_;
+    }
+
+    /* dyptrk: the back pointers index S */
+    if (!okreals_(s->s, 60, -REALMAX, REALMAX) || !okints_(s->p, 120, 0, 60) || s->ipoint < 0 || s->ipoint > 1 ||
+        !okreals_(&s->alphax, 1, -REALMAX, REALMAX) || !okreals_(&s->minsc, 1, -REALMAX, REALMAX)) {
+        return FALSE_;
+    }
+
+    /* chanwr */
+    return s->isync >= 0 && s->isync <= 1;
+} /* okenc_ */
+
+/* TRUE_ if the decoder state S can be carried on from. */
+
+static logical okdec_(const struct lpc10_decoder_state* s) {
+    integer i__;
+
+    /* decode: pitches are 20 to 156 (DPIT is 0 before the first */
+    /* frames), RMS codes 5 bits, and ERATE at most its steady value */
+    /* for the 10 errors a frame HAM84V can count */
+    if (s->iptold < 20 || s->iptold > 156 || s->iavgp < 20 || s->iavgp > 156 || s->ivp2h < 0 || s->ivp2h > 1 ||
+        s->iovoic < 0 || s->iovoic > 3 || s->erate < 0 || s->erate > 32640) {
+        return FALSE_;
+    }
+    for (i__ = 0; i__ < LPC10_ORDER; ++i__) {
+        if (!okints_(&s->drc[i__ * 3], 3, -(1 << (rcbits[i__] - 1)), (1 << (rcbits[i__] - 1)) - 1)) {
+            return FALSE_;
+        }
+    }
+    if (!okints_(s->dpit, 3, 0, 156) || !okints_(s->drms, 3, 0, 31) || s->hamfix < 0 || s->hamfix > 5 ||
+        s->hambad < 0 || s->hambad > 5) {
+        return FALSE_;
+    }
+
+    /* synths and lpc10_conceal.  BUF holds what PITSYN has synthesized */
+    /* past the last frame, which is LFRAME less JSAMP, and a frame */
+    /* before the first. */
+    if (!okreals_(s->buf, s->buflen, -SYNMAX, SYNMAX) || s->nlost < 0) {
+        return FALSE_;
+    }
+    if (s->first_pitsyn ? s->buflen != LPC10_LFRAME : s->jsamp != LPC10_LFRAME - s->buflen) {
+        return FALSE_;
+    }
+
+    /* pitsyn: RMSO is an RMS DECODE returns, RCO reflection */
+    /* coefficients SYNTHS has limited */
+    if (!okreals_(&s->rmso, 1, 0.f, 1024.f)) {
+        return FALSE_;
+    }
+    if (!s->first_pitsyn &&
+        (s->ivoico < 0 || s->ivoico > 1 || s->ipito < 20 || s->ipito > 156 || !okreals_(s->rco, 10, -.99f, .99f))) {
+        return FALSE_;
+    }
+
+    /* bsynz, random and deemp: RANDOM's lags are 3 apart */
+    if (!okreals_(s->exc, LPC10_ORDER, -SYNMAX, SYNMAX) || !okreals_(s->exc2, LPC10_ORDER, -SYNMAX, SYNMAX) ||
+        !okreals_(&s->lpi1, 1, -SYNMAX, SYNMAX) || !okreals_(&s->lpi2, 1, -SYNMAX, SYNMAX) ||
+        !okreals_(&s->lpi3, 1, -SYNMAX, SYNMAX) || !okreals_(&s->hpi1, 1, -SYNMAX, SYNMAX) ||
+        !okreals_(&s->hpi2, 1, -SYNMAX, SYNMAX) || !okreals_(&s->hpi3, 1, -SYNMAX, SYNMAX) ||
+        !okreals_(&s->rmso_bsynz, 1, 0.f, 1024.f) || !okreals_(&s->dei1, 1, -SYNMAX, SYNMAX) ||
+        !okreals_(&s->dei2, 1, -SYNMAX, SYNMAX) || !okreals_(&s->deo1, 1, -SYNMAX, SYNMAX) ||
+        !okreals_(&s->deo2, 1, -SYNMAX, SYNMAX) || !okreals_(&s->deo3, 1, -SYNMAX, SYNMAX)) {
+        return FALSE_;
+    }
+    return s->j >= 1 && s->j <= 5 && s->k == (s->j + 2) % 5 + 1;
+} /* okdec_ */
+
+/* ***************************************************************** */
+
+/* Save an encoder state to at most LPC10_ENCODER_STATE_BYTES bytes. */
+/* Returns the number of bytes written. */
+
+int lpc10_encoder_state_save(const struct lpc10_encoder_state* st, unsigned char* bytes) {
+    struct lpc10_encoder_state s;
+    stbuf b = {bytes, 0, 0, 0};
+
+    s = *st;
+    xenc_(&b, &s);
+    return (int)(b.out - bytes);
+} /* lpc10_encoder_state_save */
+
+/* Restore an encoder state from the NBYTES bytes of one saved by */
+/* LPC10_ENCODER_STATE_SAVE.  Returns the number of bytes read, or -1 */
+/* if they are not an encoder state of this version (or are cut off, */
+/* or hold a value the encoder could not have left in the state), */
+/* in which case ST is left as it was. */
+
+int lpc10_encoder_state_restore(struct lpc10_encoder_state* st, const unsigned char* bytes, int nbytes) {
+    struct lpc10_encoder_state s;
+    stbuf b = {0, bytes, bytes + nbytes, 0};
+
+    s = *st;
+    xenc_(&b, &s);
+    if (b.bad || !okenc_(&s)) {
+        return -1;
+    }
+    *st = s;
+    return (int)(b.in - bytes);
+} /* lpc10_encoder_state_restore */
+
+/* Save a decoder state to at most LPC10_DECODER_STATE_BYTES bytes. */
+/* Returns the number of bytes written. */
+
+int lpc10_decoder_state_save(const struct lpc10_decoder_state* st, unsigned char* bytes) {
+    struct lpc10_decoder_state s;
+    stbuf b = {bytes, 0, 0, 0};
+
+    s = *st;
+    xdec_(&b, &s);
+    return (int)(b.out - bytes);
+} /* lpc10_decoder_state_save */
+
+/* Restore a decoder state from the NBYTES bytes of one saved by */
+/* LPC10_DECODER_STATE_SAVE.  Returns the number of bytes read, or -1 */
+/* if they are not a decoder state of this version (or are cut off, */
+/* or hold a value the decoder could not have left in the state), */
+/* in which case ST is left as it was. */
+
+int lpc10_decoder_state_restore(struct lpc10_decoder_state* st, const unsigned char* bytes, int nbytes) {
+    struct lpc10_decoder_state s;
+    stbuf b = {0, bytes, bytes + nbytes, 0};
+
+    s = *st;
+    xdec_(&b, &s);
+    if (b.bad || !okdec_(&s)) {
+        return -1;
+    }
+    *st = s;
+    return (int)(b.in - bytes);
+} /* lpc10_decoder_state_restore */
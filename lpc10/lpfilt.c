@@ -13,7 +13,7 @@
 
 #include "f2c.h"
 
-extern int lpfilt_(real* inbuf, real* lpbuf, integer* len, integer* nsamp);
+extern int lpfilt_(real* inbuf, real* lpbuf, const integer* len, const integer* nsamp);
 
 /* *********************************************************************** */
 
@@ -52,7 +52,7 @@ extern int lpfilt_(real* inbuf, real* lpbuf, integer* len, integer* nsamp);
 
 /* This subroutine has no local state. */
 
-/* Subroutine */ int lpfilt_(real* inbuf, real* lpbuf, integer* len, integer* nsamp) {
+/* Subroutine */ int lpfilt_(real* inbuf, real* lpbuf, const integer* len, const integer* nsamp) {
     /* System generated locals */
     integer i__1;
 
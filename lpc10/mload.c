@@ -13,7 +13,7 @@
 
 #include "f2c.h"
 
-extern int mload_(integer* order, integer* awins, integer* awinf, real* speech, real* phi, real* psi);
+extern int mload_(const integer* order, const integer* awins, integer* awinf, real* speech, real* phi, real* psi);
 
 /* ***************************************************************** */
 
@@ -68,7 +68,7 @@ extern int mload_(integer* order, integer* awins, integer* awinf, real* speech,
 
 /* This subroutine has no local state. */
 
-/* Subroutine */ int mload_(integer* order, integer* awins, integer* awinf, real* speech, real* phi, real* psi) {
+/* Subroutine */ int mload_(const integer* order, const integer* awins, integer* awinf, real* speech, real* phi, real* psi) {
     /* System generated locals */
     integer phi_dim1, phi_offset, i__1, i__2;
 
@@ -24,15 +24,15 @@
 extern int onset_(real* pebuf,
                   integer* osbuf,
                   integer* osptr,
-                  integer* oslen,
-                  integer* sbufl,
-                  integer* sbufh,
-                  integer* lframe,
+                  const integer* oslen,
+                  const integer* sbufl,
+                  const integer* sbufh,
+                  const integer* lframe,
                   struct lpc10_encoder_state* st);
 
 /* Table of constant values */
 
-static real c_b2 = 1.f;
+static const real c_b2 = 1.f;
 
 /* ****************************************************************** */
 
@@ -105,10 +105,10 @@ static real c_b2 = 1.f;
 /* Subroutine */ int onset_(real* pebuf,
                             integer* osbuf,
                             integer* osptr,
-                            integer* oslen,
-                            integer* sbufl,
-                            integer* sbufh,
-                            integer* lframe,
+                            const integer* oslen,
+                            const integer* sbufl,
+                            const integer* sbufh,
+                            const integer* lframe,
                             struct lpc10_encoder_state* st) {
     /* Initialized data */
 
@@ -125,7 +125,7 @@ static real c_b2 = 1.f;
     real r__1;
 
     /* Builtin functions */
-    double r_sign(real*, real*);
+    double r_sign(const real*, real*);
 
     /* Local variables */
     integer i__;
@@ -267,5 +267,13 @@ static real c_b2 = 1.f;
             *hyst = FALSE_;
         }
     }
+    /*   L2SUM1 is a running sum, updated with one subtraction and one */
+    /*   addition per sample.  Recompute it from the 8 FPC values it */
+    /*   stands for, which are in L2BUF(L2PTR2) onwards, so that its */
+    /*   rounding errors do not build up over a long stream. */
+    *l2sum1 = 0.f;
+    for (i__ = 0; i__ < 8; ++i__) {
+        *l2sum1 += l2buf[(*l2ptr2 - 1 + i__) % 16];
+    }
     return 0;
 } /* onset_ */
@@ -21,12 +21,10 @@
 
 #include "f2c.h"
 
-extern int pitsyn_(integer* order,
-                   integer* voice,
+extern int pitsyn_(integer* voice,
                    integer* pitch,
                    real* rms,
                    real* rc,
-                   integer* lframe,
                    integer* ivuv,
                    integer* ipiti,
                    real* rmsi,
@@ -74,11 +72,13 @@ extern int pitsyn_(integer* order,
 
 /*   Synthesize a single pitch epoch */
 
+/* The synthesis order ORDER (number of RC's) and the length of the */
+/* speech buffer LFRAME are the compile-time constants LPC10_ORDER and */
+/* LPC10_LFRAME. */
+
 /* Input: */
-/*  ORDER  - Synthesis order (number of RC's) */
 /*  VOICE  - Half frame voicing decisions */
 /*           Indices 1 through 2 read. */
-/*  LFRAME - Length of speech buffer */
 /* Input/Output: */
 /*  PITCH  - Pitch */
 /*           This value should be in the range MINPIT (20) to MAXPIT */
@@ -107,12 +107,10 @@ extern int pitsyn_(integer* order,
 /*  RATIO  - Previous to present energy ratio */
 /*           Always assigned a value. */
 
-/* Subroutine */ int pitsyn_(integer* order,
-                             integer* voice,
+/* Subroutine */ int pitsyn_(integer* voice,
                              integer* pitch,
                              real* rms,
                              real* rc,
-                             integer* lframe,
                              integer* ivuv,
                              integer* ipiti,
                              real* rmsi,
@@ -185,7 +183,7 @@ extern int pitsyn_(integer* order,
         --rc;
     }
     if (rci) {
-        rci_dim1 = *order;
+        rci_dim1 = LPC10_ORDER;
         rci_offset = rci_dim1 + 1;
         rci -= rci_offset;
     }
@@ -222,10 +220,10 @@ extern int pitsyn_(integer* order,
         lsamp = 0;
         ivoice = voice[2];
         if (ivoice == 0) {
-            *pitch = *lframe / 4;
+            *pitch = LPC10_LFRAME / 4;
         }
-        *nout = *lframe / *pitch;
-        *jsamp = *lframe - *nout * *pitch;
+        *nout = LPC10_LFRAME / *pitch;
+        *jsamp = LPC10_LFRAME - *nout * *pitch;
 
         /*          SYNTHS only calls this subroutine with PITCH in the range
         20 */
@@ -238,7 +236,7 @@ extern int pitsyn_(integer* order,
 
         i__1 = *nout;
         for (i__ = 1; i__ <= i__1; ++i__) {
-            i__2 = *order;
+            i__2 = LPC10_ORDER;
             for (j = 1; j <= i__2; ++j) {
                 rci[j + i__ * rci_dim1] = rc[j];
             }
@@ -249,7 +247,7 @@ extern int pitsyn_(integer* order,
         *first = FALSE_;
     } else {
         vflag = 0;
-        lsamp = *lframe + *jsamp;
+        lsamp = LPC10_LFRAME + *jsamp;
         slope = (*pitch - *ipito) / (real)lsamp;
         *nout = 0;
         jused = 0;
@@ -257,7 +255,7 @@ extern int pitsyn_(integer* order,
         if (voice[1] == *ivoico && voice[2] == voice[1]) {
             if (voice[2] == 0) {
                 /* SSUV - -   0  ,  0  ,  0 */
-                *pitch = *lframe / 4;
+                *pitch = LPC10_LFRAME / 4;
                 *ipito = *pitch;
                 if (*ratio > 8.f) {
                     *rmso = *rms;
@@ -270,10 +268,10 @@ extern int pitsyn_(integer* order,
             if (*ivoico != 1) {
                 if (*ivoico == voice[1]) {
                     /* UV2VC2 - -  0  ,  0  ,  1 */
-                    nl = lsamp - *lframe / 4;
+                    nl = lsamp - LPC10_LFRAME / 4;
                 } else {
                     /* UV2VC1 - -  0  ,  1  ,  1 */
-                    nl = lsamp - *lframe * 3 / 4;
+                    nl = lsamp - LPC10_LFRAME * 3 / 4;
                 }
                 ipiti[1] = nl / 2;
                 ipiti[2] = nl - ipiti[1];
@@ -281,7 +279,7 @@ extern int pitsyn_(integer* order,
                 ivuv[2] = 0;
                 rmsi[1] = *rmso;
                 rmsi[2] = *rmso;
-                i__1 = *order;
+                i__1 = LPC10_ORDER;
                 for (i__ = 1; i__ <= i__1; ++i__) {
                     rci[i__ + rci_dim1] = rco[i__ - 1];
                     rci[i__ + (rci_dim1 << 1)] = rco[i__ - 1];
@@ -296,12 +294,12 @@ extern int pitsyn_(integer* order,
             } else {
                 if (*ivoico != voice[1]) {
                     /* VC2UV1 - -   1  ,  0  ,  0 */
-                    lsamp = *lframe / 4 + *jsamp;
+                    lsamp = LPC10_LFRAME / 4 + *jsamp;
                 } else {
                     /* VC2UV2 - -   1  ,  1  ,  0 */
-                    lsamp = *lframe * 3 / 4 + *jsamp;
+                    lsamp = LPC10_LFRAME * 3 / 4 + *jsamp;
                 }
-                i__1 = *order;
+                i__1 = LPC10_ORDER;
                 for (i__ = 1; i__ <= i__1; ++i__) {
                     yarc[i__ - 1] = rc[i__];
                     rc[i__] = rco[i__ - 1];
@@ -433,7 +431,7 @@ extern int pitsyn_(integer* order,
                     ivuv[*nout] = ivoice;
                     jused += ip;
                     prop = (jused - ip / 2) / (real)lsamp;
-                    i__2 = *order;
+                    i__2 = LPC10_ORDER;
                     for (j = 1; j <= i__2; ++j) {
                         alro = log((rco[j - 1] + 1) / (1 - rco[j - 1]));
                         alrn = log((rc[j] + 1) / (1 - rc[j]));
@@ -497,7 +495,7 @@ extern int pitsyn_(integer* order,
 
             vflag = 0;
             istart = jused + 1;
-            lsamp = *lframe + *jsamp;
+            lsamp = LPC10_LFRAME + *jsamp;
             slope = 0.f;
             ivoice = 0;
             uvpit = (real)((lsamp - istart) / 2);
@@ -505,7 +503,7 @@ extern int pitsyn_(integer* order,
                 uvpit /= 2;
             }
             *rmso = *rms;
-            i__1 = *order;
+            i__1 = LPC10_ORDER;
             for (i__ = 1; i__ <= i__1; ++i__) {
                 rc[i__] = yarc[i__ - 1];
                 rco[i__ - 1] = yarc[i__ - 1];
@@ -522,7 +520,7 @@ extern int pitsyn_(integer* order,
         *ivoico = voice[2];
         *ipito = *pitch;
         *rmso = *rms;
-        i__1 = *order;
+        i__1 = LPC10_ORDER;
         for (i__ = 1; i__ <= i__1; ++i__) {
             rco[i__ - 1] = rc[i__];
         }
@@ -28,12 +28,12 @@ with anything else, and I'll get on that case before we go stable.
 extern int placea_(integer* ipitch,
                    integer* voibuf,
                    integer* obound,
-                   integer* af,
+                   const integer* af,
                    integer* vwin,
                    integer* awin,
                    integer* ewin,
-                   integer* lframe,
-                   integer* maxwin);
+                   const integer* lframe,
+                   const integer* maxwin);
 
 /* *********************************************************************** */
 
@@ -95,12 +95,12 @@ extern int placea_(integer* ipitch,
 /* Subroutine */ int placea_(integer* ipitch,
                              integer* voibuf,
                              integer* obound,
-                             integer* af,
+                             const integer* af,
                              integer* vwin,
                              integer* awin,
                              integer* ewin,
-                             integer* lframe,
-                             integer* maxwin) {
+                             const integer* lframe,
+                             const integer* maxwin) {
     /* System generated locals */
     real r__1;
 
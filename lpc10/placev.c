@@ -15,15 +15,15 @@
 
 extern int placev_(integer* osbuf,
                    integer* osptr,
-                   integer* oslen,
+                   const integer* oslen,
                    integer* obound,
                    integer* vwin,
-                   integer* af,
-                   integer* lframe,
-                   integer* minwin,
-                   integer* maxwin,
-                   integer* dvwinl,
-                   integer* dvwinh);
+                   const integer* af,
+                   const integer* lframe,
+                   const integer* minwin,
+                   const integer* maxwin,
+                   const integer* dvwinl,
+                   const integer* dvwinh);
 
 /* ****************************************************************** */
 
@@ -87,15 +87,15 @@ extern int placev_(integer* osbuf,
 
 /* Subroutine */ int placev_(integer* osbuf,
                              integer* osptr,
-                             integer* oslen,
+                             const integer* oslen,
                              integer* obound,
                              integer* vwin,
-                             integer* af,
-                             integer* lframe,
-                             integer* minwin,
-                             integer* maxwin,
-                             integer* dvwinl,
-                             integer* dvwinh) {
+                             const integer* af,
+                             const integer* lframe,
+                             const integer* minwin,
+                             const integer* maxwin,
+                             const integer* dvwinl,
+                             const integer* dvwinh) {
     /* System generated locals */
     integer i__1, i__2;
 
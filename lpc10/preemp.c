@@ -13,7 +13,7 @@
 
 #include "f2c.h"
 
-extern int preemp_(real* inbuf, real* pebuf, integer* nsamp, real* coef, real* z__);
+extern int preemp_(real* inbuf, real* pebuf, const integer* nsamp, const real* coef, real* z__);
 
 /* ******************************************************************* */
 
@@ -51,7 +51,7 @@ extern int preemp_(real* inbuf, real* pebuf, integer* nsamp, real* coef, real* z
 
 /* This subroutine has no local state. */
 
-/* Subroutine */ int preemp_(real* inbuf, real* pebuf, integer* nsamp, real* coef, real* z__) {
+/* Subroutine */ int preemp_(real* inbuf, real* pebuf, const integer* nsamp, const real* coef, real* z__) {
     /* System generated locals */
     integer i__1;
 
@@ -21,11 +21,11 @@
 
 #include "f2c.h"
 
-extern int prepro_(real* speech, integer* length, struct lpc10_encoder_state* st);
+extern int prepro_(real* speech, const integer* length, struct lpc10_encoder_state* st);
 
 /* Table of constant values */
 
-static integer c__1 = 1;
+static const integer c__1 = 1;
 
 /* ********************************************************************* */
 
@@ -68,8 +68,8 @@ static integer c__1 = 1;
 /* stream for this filter, or reinitialize its state for any other */
 /* reason, call the ENTRY INITPREPRO. */
 
-/* Subroutine */ int prepro_(real* speech, integer* length, struct lpc10_encoder_state* st) {
-    extern /* Subroutine */ int hp100_(real*, integer*, integer*, struct lpc10_encoder_state*);
+/* Subroutine */ int prepro_(real* speech, const integer* length, struct lpc10_encoder_state* st) {
+    extern /* Subroutine */ int hp100_(real*, const integer*, const integer*, struct lpc10_encoder_state*);
 
     /*       Arguments */
     /*   High Pass Filter at 100 Hz */
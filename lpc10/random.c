@@ -93,3 +93,69 @@ integer random_(struct lpc10_decoder_state* st) {
     }
     return ret_val;
 } /* random_ */
+
+/* Advance the generator by N calls of RANDOM without making them. */
+
+/* Five calls bring J and K back to where they were, having added each */
+/* element of Y to another once: a linear map of Y modulo 2**16, which */
+/* is raised to the power N/5 by repeated squaring, so that the cost */
+/* grows with LOG(N) and not with N. */
+
+void random_skip_(struct lpc10_decoder_state* st, unsigned long long n) {
+    unsigned int m[25], p[25], t[25], y[5];
+    unsigned long long q;
+    integer i__, j, k, l;
+
+    /* M is the map of five calls from the current J and K, P the */
+    /* product of the powers of M so far. */
+    for (i__ = 0; i__ < 25; ++i__) {
+        m[i__] = p[i__] = i__ % 6 == 0;
+    }
+    j = st->j;
+    k = st->k;
+    for (l = 0; l < 5; ++l) {
+        for (i__ = 0; i__ < 5; ++i__) {
+            m[(k - 1) * 5 + i__] += m[(j - 1) * 5 + i__];
+        }
+        if (--k <= 0) {
+            k = 5;
+        }
+        if (--j <= 0) {
+            j = 5;
+        }
+    }
+    for (q = n / 5; q > 0; q >>= 1) {
+        if (q & 1) {
+            for (i__ = 0; i__ < 25; ++i__) {
+                t[i__] = 0;
+                for (l = 0; l < 5; ++l) {
+                    t[i__] += m[i__ / 5 * 5 + l] * p[l * 5 + i__ % 5];
+                }
+            }
+            for (i__ = 0; i__ < 25; ++i__) {
+                p[i__] = t[i__] & 0xffff;
+            }
+        }
+        for (i__ = 0; i__ < 25; ++i__) {
+            t[i__] = 0;
+            for (l = 0; l < 5; ++l) {
+                t[i__] += m[i__ / 5 * 5 + l] * m[l * 5 + i__ % 5];
+            }
+        }
+        for (i__ = 0; i__ < 25; ++i__) {
+            m[i__] = t[i__] & 0xffff;
+        }
+    }
+    for (i__ = 0; i__ < 5; ++i__) {
+        y[i__] = 0;
+        for (l = 0; l < 5; ++l) {
+            y[i__] += p[i__ * 5 + l] * (unsigned short)st->y[l];
+        }
+    }
+    for (i__ = 0; i__ < 5; ++i__) {
+        st->y[i__] = (shortint)(y[i__] & 0xffff);
+    }
+    for (l = (integer)(n % 5); l > 0; --l) {
+        random_(st);
+    }
+} /* random_skip_ */
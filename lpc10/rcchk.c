@@ -13,7 +13,7 @@
 
 #include "f2c.h"
 
-extern int rcchk_(integer* order, real* rc1f, real* rc2f);
+extern int rcchk_(const integer* order, real* rc1f, real* rc2f);
 
 /* ********************************************************************* */
 
@@ -51,7 +51,7 @@ extern int rcchk_(integer* order, real* rc1f, real* rc2f);
 
 /* This subroutine has no local state. */
 
-/* Subroutine */ int rcchk_(integer* order, real* rc1f, real* rc2f) {
+/* Subroutine */ int rcchk_(const integer* order, real* rc1f, real* rc2f) {
     /* System generated locals */
     integer i__1;
     real r__1;
@@ -20,21 +20,132 @@
 */
 
 #include "f2c.h"
+#include "lpcprof.h"
 
 extern int synths_(integer* voice, integer* pitch, real* rms, real* rc, real* speech, integer* k, struct lpc10_decoder_state* st);
 
-/* Common Block Declarations */
+/* Table of constant values */
 
-extern struct {
-    integer order, lframe;
-    logical corrp;
-} contrl_;
+static const real c_b2 = .7f;
+static const integer c_order = LPC10_ORDER;
 
-#define contrl_1 contrl_
+/* Frames whose decoded RMS is at or below SILRMS, and which follow a */
+/* frame that was itself unvoiced and at or below SILRMS, are */
+/* synthesized by SYNSIL instead of PITSYN/BSYNZ.  7 is the fourth */
+/* smallest value DECODE can return, about 55 dB below full scale. */
 
-/* Table of constant values */
+#define SILRMS 7.f
+
+/* Level of the noise of BSYNZ and DEEMP over steady silent frames, */
+/* relative to that of SYNSIL without it.  Measured on the lpc10bench */
+/* corpus with pauses of white and of first order low and high pass */
+/* noise: the ratio was .83 to .99, as the noise of BSYNZ is shaped */
+/* by all of RC and carries its impulse doublets; this is the */
+/* geometric mean. */
+
+#define SILGAIN .9f
+
+/* ***************************************************************** */
+
+/* TRUE_ if the frame with voicing VOICE(1..2) and RMS is one for */
+/* SYNSIL, given the PITSYN state. */
+
+static logical silfr_(integer* voice, real* rms, struct lpc10_decoder_state* st) {
+    if (st->first_pitsyn || voice[0] != 0 || voice[1] != 0 || st->ivoico != 0) {
+        return FALSE_;
+    }
+    if (*rms > SILRMS || st->rmso > SILRMS || st->jsamp >= LPC10_LFRAME / 4) {
+        return FALSE_;
+    }
+    return TRUE_;
+} /* silfr_ */
 
-static real c_b2 = .7f;
+/* Leave the PITSYN state as PITSYN would after the frame SYNSIL */
+/* synthesized, with RMS and RC(1..ORDER). */
+
+static void silpit_(real* rms, real* rc, struct lpc10_decoder_state* st) {
+    integer i__;
+
+    st->ivoico = 0;
+    st->ipito = LPC10_LFRAME / 4;
+    st->rmso = *rms;
+    for (i__ = 0; i__ < LPC10_ORDER; ++i__) {
+        st->rco[i__] = rc[i__];
+    }
+} /* silpit_ */
+
+/* ***************************************************************** */
+
+/* Cheap synthesis of one frame of steady low-level unvoiced speech. */
+
+/* For a frame in the 000 state of PITSYN with no change in level, */
+/* PITSYN would emit LFRAME/4 length epochs with parameters that are */
+/* already the ones of the previous frame, and BSYNZ would only shape */
+/* a noise floor far below the level of speech.  Here white noise is */
+/* shaped by the first order all-pole filter of RC(1) only, which */
+/* gives it the tilt of the spectrum of BSYNZ, scaled to RMS as BSYNZ */
+/* scales each epoch, and without the impulse doublets, and it passes */
+/* through DEEMP so that its filter memory remains continuous. */
+/* RANDOM is called exactly as often as BSYNZ would, so that the */
+/* frames synthesized after the silence get the noise BSYNZ would have */
+/* given them.  The PITSYN state is updated exactly as PITSYN would */
+/* have, and the BSYNZ filter memory is left at the level of the last */
+/* synthesized epoch, which BSYNZ rescales itself on the next call. */
+/* Returns TRUE_ if the frame was handled. */
+
+static logical synsil_(integer* voice, real* rms, real* rc, real* sout, struct lpc10_decoder_state* st) {
+    integer i__, j, n;
+    real gain, ssq, x, y;
+
+    /* Builtin functions */
+    double sqrt(doublereal);
+
+    extern /* Subroutine */ int deemp_(real*, integer*, struct lpc10_decoder_state*);
+    extern integer random_(struct lpc10_decoder_state*);
+    LPC10_PROF_DECL
+
+    /* Parameter adjustments */
+    --voice;
+    --rc;
+    --sout;
+
+    /* Function Body */
+    if (!silfr_(&voice[1], rms, st)) {
+        return FALSE_;
+    }
+    if (*rms < 1.f) {
+        *rms = 1.f;
+    }
+    /* The LFRAME/4 length epochs of BSYNZ: a sample of noise each, */
+    /* then the position of the impulse doublet, which is drawn and */
+    /* left unused.  The filter starts in its steady state. */
+    y = 0.f;
+    ssq = 0.f;
+    for (j = 0; j < 4; ++j) {
+        for (i__ = 1; i__ <= LPC10_LFRAME / 4; ++i__) {
+            x = (real)(random_(st) / 64);
+            if (j == 0 && i__ == 1) {
+                y = x / sqrt(1.f - rc[1] * rc[1]);
+            } else {
+                y = x + rc[1] * y;
+            }
+            sout[j * (LPC10_LFRAME / 4) + i__] = y;
+            ssq += y * y;
+        }
+        random_(st);
+    }
+    n = LPC10_LFRAME;
+    gain = SILGAIN * *rms * sqrt(n / ssq);
+    for (i__ = 1; i__ <= n; ++i__) {
+        sout[i__] *= gain;
+    }
+    LPC10_PROF_START();
+    deemp_(&sout[1], &n, st);
+    LPC10_PROF_STOP(st, LPC10_PROF_DEEMP);
+
+    silpit_(rms, &rc[1], st);
+    return TRUE_;
+} /* synsil_ */
 
 /* ***************************************************************** */
 
@@ -143,12 +254,13 @@ synths_(integer* voice, integer* pitch, real* rms, real* rc, real* speech, integ
     real ratio;
     integer ipiti[16];
     extern int bsynz_(real*, integer*, integer*, real*, real*, real*, real*, struct lpc10_decoder_state*),
-        irc2pc_(real*, real*, integer*, real*, real*);
+        irc2pc_(real*, real*, const integer*, const real*, real*);
     real g2pass;
     real pc[10];
-    extern /* Subroutine */ int pitsyn_(integer*, integer*, integer*, real*, real*, integer*, integer*, integer*, real*, real*,
-                                        integer*, real*, struct lpc10_decoder_state*);
+    extern /* Subroutine */ int pitsyn_(integer*, integer*, real*, real*, integer*, integer*, real*, real*, integer*, real*,
+                                        struct lpc10_decoder_state*);
     real rci[160] /* was [10][16] */;
+    LPC10_PROF_DECL
 
     /*   LPC Configuration parameters: */
     /* Frame size, Prediction order, Pitch period */
@@ -264,7 +376,7 @@ synths_(integer* voice, integer* pitch, real* rms, real* rc, real* speech, integ
     /* Computing MAX */
     i__1 = min(*pitch, 156);
     *pitch = max(i__1, 20);
-    i__1 = contrl_1.order;
+    i__1 = LPC10_ORDER;
     for (i__ = 1; i__ <= i__1; ++i__) {
         /* Computing MAX */
         /* Computing MIN */
@@ -272,17 +384,32 @@ synths_(integer* voice, integer* pitch, real* rms, real* rc, real* speech, integ
         r__1 = min(r__2, .99f);
         rc[i__] = max(r__1, -.99f);
     }
-    pitsyn_(&contrl_1.order, &voice[1], pitch, rms, &rc[1], &contrl_1.lframe, ivuv, ipiti, rmsi, rci, &nout, &ratio, st);
-    if (nout > 0) {
+    st->silent = synsil_(&voice[1], rms, &rc[1], &buf[*buflen], st);
+    if (st->silent) {
+        *pitch = LPC10_LFRAME / 4;
+        nout = 0;
+        *buflen += LPC10_LFRAME;
+    } else {
+        LPC10_PROF_START();
+        pitsyn_(&voice[1], pitch, rms, &rc[1], ivuv, ipiti, rmsi, rci, &nout, &ratio, st);
+        LPC10_PROF_STOP(st, LPC10_PROF_PITSYN);
+    }
+    if (nout > 0 || st->silent) {
         i__1 = nout;
         for (j = 1; j <= i__1; ++j) {
             /*             Add synthesized speech for pitch period J to the en
             d of */
             /*             BUF. */
 
-            irc2pc_(&rci[j * 10 - 10], pc, &contrl_1.order, &c_b2, &g2pass);
+            LPC10_PROF_START();
+            irc2pc_(&rci[j * 10 - 10], pc, &c_order, &c_b2, &g2pass);
+            LPC10_PROF_STOP(st, LPC10_PROF_IRC2PC);
+            LPC10_PROF_START();
             bsynz_(pc, &ipiti[j - 1], &ivuv[j - 1], &buf[*buflen], &rmsi[j - 1], &ratio, &g2pass, st);
+            LPC10_PROF_STOP(st, LPC10_PROF_BSYNZ);
+            LPC10_PROF_START();
             deemp_(&buf[*buflen], &ipiti[j - 1], st);
+            LPC10_PROF_STOP(st, LPC10_PROF_DEEMP);
             *buflen += ipiti[j - 1];
         }
 
@@ -304,3 +431,51 @@ synths_(integer* voice, integer* pitch, real* rms, real* rc, real* speech, integ
     }
     return 0;
 } /* synths_ */
+
+/* ***************************************************************** */
+
+/* Follow SYNTHS through one frame without synthesizing it.  The */
+/* arguments are limited and the PITSYN state updated exactly as by */
+/* SYNTHS, which only depends on the frames decoded, not on the */
+/* samples synthesized, and so is BUFLEN; the BSYNZ and DEEMP */
+/* filters, the samples in BUF and the random number generator are */
+/* left alone.  Returns the number of calls of RANDOM that SYNTHS */
+/* would have made for the frame. */
+
+integer synctl_(integer* voice, integer* pitch, real* rms, real* rc, struct lpc10_decoder_state* st) {
+    integer nout, ivuv[16], ipiti[16], i__, j, n;
+    real rmsi[16], rci[160], ratio, r__1;
+    extern /* Subroutine */ int pitsyn_(integer*, integer*, real*, real*, integer*, integer*, real*, real*, integer*, real*,
+                                        struct lpc10_decoder_state*);
+
+    i__ = min(*pitch, 156);
+    *pitch = max(i__, 20);
+    for (i__ = 0; i__ < LPC10_ORDER; ++i__) {
+        r__1 = min(rc[i__], .99f);
+        rc[i__] = max(r__1, -.99f);
+    }
+    st->silent = silfr_(voice, rms, st);
+    if (st->silent) {
+        /* SYNSIL: the four LFRAME/4 length epochs of BSYNZ */
+        if (*rms < 1.f) {
+            *rms = 1.f;
+        }
+        silpit_(rms, rc, st);
+        *pitch = LPC10_LFRAME / 4;
+        return (LPC10_LFRAME / 4 + 1) * 4;
+    }
+    pitsyn_(voice, pitch, rms, rc, ivuv, ipiti, rmsi, rci, &nout, &ratio, st);
+    if (nout == 0) {
+        return 0;
+    }
+
+    /* BSYNZ: a sample of noise each, and the position of the impulse */
+    /* doublet of an unvoiced epoch */
+    n = 0;
+    for (j = 0; j < nout; ++j) {
+        st->buflen += ipiti[j];
+        n += ipiti[j] + (ivuv[j] == 0);
+    }
+    st->buflen += -LPC10_LFRAME;
+    return n;
+} /* synctl_ */
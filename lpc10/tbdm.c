@@ -14,7 +14,14 @@
 #include "f2c.h"
 
 extern int
-tbdm_(real* speech, integer* lpita, integer* tau, integer* ltau, real* amdf, integer* minptr, integer* maxptr, integer* mintau);
+tbdm_(real* speech,
+      const integer* lpita,
+      const integer* tau,
+      const integer* ltau,
+      real* amdf,
+      integer* minptr,
+      integer* maxptr,
+      integer* mintau);
 
 /* ********************************************************************** */
 
@@ -64,14 +71,22 @@ tbdm_(real* speech, integer* lpita, integer* tau, integer* ltau, real* amdf, int
 /* This subroutine has no local state. */
 
 /* Subroutine */ int
-tbdm_(real* speech, integer* lpita, integer* tau, integer* ltau, real* amdf, integer* minptr, integer* maxptr, integer* mintau) {
+tbdm_(real* speech,
+      const integer* lpita,
+      const integer* tau,
+      const integer* ltau,
+      real* amdf,
+      integer* minptr,
+      integer* maxptr,
+      integer* mintau) {
     /* System generated locals */
     integer i__1, i__2, i__3, i__4;
 
     /* Local variables */
     real amdf2[6];
     integer minp2, ltau2, maxp2, i__;
-    extern /* Subroutine */ int difmag_(real*, integer*, integer*, integer*, integer*, real*, integer*, integer*);
+    extern /* Subroutine */ int difmag_(real*, const integer*, const integer*, const integer*, const integer*, real*, integer*,
+                                        integer*);
     integer minamd, ptr, tau2[6];
 
     /* 	Arguments */
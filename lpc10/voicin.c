@@ -24,7 +24,7 @@
 extern int voicin_(integer* vwin,
                    real* inbuf,
                    real* lpbuf,
-                   integer* buflim,
+                   const integer* buflim,
                    integer* half,
                    real* minamd,
                    real* maxamd,
@@ -32,18 +32,9 @@ extern int voicin_(integer* vwin,
                    real* ivrc,
                    integer* obound,
                    integer* voibuf,
-                   integer* af,
+                   const integer* af,
                    struct lpc10_encoder_state* st);
 
-/* Common Block Declarations */
-
-extern struct {
-    integer order, lframe;
-    logical corrp;
-} contrl_;
-
-#define contrl_1 contrl_
-
 /****************************************************************************/
 
 /* 	VOICIN Version 52 */
@@ -234,7 +225,7 @@ s*/
 /* Subroutine */ int voicin_(integer* vwin,
                              real* inbuf,
                              real* lpbuf,
-                             integer* buflim,
+                             const integer* buflim,
                              integer* half,
                              real* minamd,
                              real* maxamd,
@@ -242,12 +233,12 @@ s*/
                              real* ivrc,
                              integer* obound,
                              integer* voibuf,
-                             integer* af,
+                             const integer* af,
                              struct lpc10_encoder_state* st) {
     /* Initialized data */
 
     real* dither;
-    static real vdc[100] /* was [10][10] */ = {
+    static const real vdc[100] /* was [10][10] */ = {
         0.f,     1714.f, -110.f, 334.f, -4096.f, -654.f,  3752.f, 3769.f, 0.f,   1181.f,  0.f,     874.f,  -97.f,  300.f, -4096.f,
         -1021.f, 2451.f, 2527.f, 0.f,   -500.f,  0.f,     510.f,  -70.f,  250.f, -4096.f, -1270.f, 2194.f, 2491.f, 0.f,   -1500.f,
         0.f,     500.f,  -10.f,  200.f, -4096.f, -1300.f, 2e3f,   2e3f,   0.f,   -2e3f,   0.f,     500.f,  0.f,    0.f,   -4096.f,
@@ -255,8 +246,8 @@ s*/
         0.f,     0.f,    0.f,    0.f,   0.f,     0.f,     0.f,    0.f,    0.f,   0.f,     0.f,     0.f,    0.f,    0.f,   0.f,
         0.f,     0.f,    0.f,    0.f,   0.f,     0.f,     0.f,    0.f,    0.f,   0.f,     0.f,     0.f,    0.f,    0.f,   0.f,
         0.f,     0.f,    0.f,    0.f,   0.f,     0.f,     0.f,    0.f,    0.f,   0.f};
-    static integer nvdcl = 5;
-    static real vdcl[10] = {600.f, 450.f, 300.f, 200.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+    static const integer nvdcl = 5;
+    static const real vdcl[10] = {600.f, 450.f, 300.f, 200.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
 
     /* System generated locals */
     integer inbuf_offset = 0, lpbuf_offset = 0, i__1, i__2;
@@ -280,8 +271,8 @@ s*/
     real* maxmin;
     integer vstate;
     real rc1;
-    extern /* Subroutine */ int vparms_(integer*, real*, real*, integer*, integer*, real*, integer*, integer*, integer*, integer*,
-                                        real*, real*, real*, real*);
+    extern /* Subroutine */ int vparms_(integer*, real*, real*, const integer*, integer*, real*, integer*, integer*, integer*,
+                                        integer*, real*, real*, real*, real*);
     integer fbe, lbe;
     real* snr;
     real snr2;
@@ -16,7 +16,7 @@
 extern int vparms_(integer* vwin,
                    real* inbuf,
                    real* lpbuf,
-                   integer* buflim,
+                   const integer* buflim,
                    integer* half,
                    real* dither,
                    integer* mintau,
@@ -28,9 +28,30 @@ extern int vparms_(integer* vwin,
                    real* ar_b__,
                    real* ar_f__);
 
-/* Table of constant values */
+/* Number of partial sums kept for each accumulator (SIMD lanes). */
 
-static real c_b2 = 1.f;
+#define VPLANE 8
+
+/* Adds sample J of the current half window, with dither D, to lane K. */
+
+#define VPACC(k, j, d)                                                  \
+    do {                                                                \
+        x = inbuf[j];                                                   \
+        xm1 = inbuf[(j) - 1];                                           \
+        l0 = lpbuf[j];                                                  \
+        lb = lpbuf[(j) - *mintau];                                      \
+        lf = lpbuf[(j) + *mintau];                                      \
+        dith = (d);                                                     \
+        v_pre[k] += abs(x - xm1);                                       \
+        v_e0ap[k] += x * x;                                             \
+        v_rc1[k] += x * xm1;                                            \
+        v_e0[k] += l0 * l0;                                             \
+        v_eb[k] += lb * lb;                                             \
+        v_ef[k] += lf * lf;                                             \
+        v_rf[k] += l0 * lf;                                             \
+        v_rb[k] += l0 * lb;                                             \
+        v_zc[k] += (x + dith >= 0.f) != (xm1 - dith >= 0.f);            \
+    } while (0)
 
 /* ********************************************************************* */
 
@@ -100,7 +121,6 @@ static real c_b2 = 1.f;
 /*  AR_F   - Product of the noncausal forward and reverse pitch */
 /*           prediction gains */
 /* Internal: */
-/*  OLDSGN - Previous sign of dithered signal */
 /*  VLEN   - Length of voicing window */
 /*  START  - Lower address of current half of voicing window */
 /*  STOP   - Upper address of current half of voicing window */
@@ -119,7 +139,7 @@ static real c_b2 = 1.f;
 /* Subroutine */ int vparms_(integer* vwin,
                              real* inbuf,
                              real* lpbuf,
-                             integer* buflim,
+                             const integer* buflim,
                              integer* half,
                              real* dither,
                              integer* mintau,
@@ -135,14 +155,16 @@ static real c_b2 = 1.f;
     real r__1, r__2;
 
     /* Builtin functions */
-    double r_sign(real*, real*);
     integer i_nint(real*);
 
     /* Local variables */
-    integer vlen, stop, i__;
+    integer vlen, stop, i__, k, n;
     real e_pre__;
     integer start;
-    real ap_rms__, e_0__, oldsgn, lp_rms__, e_b__, e_f__, r_b__, r_f__, e0ap;
+    real ap_rms__, e_0__, lp_rms__, e_b__, e_f__, r_b__, r_f__, e0ap;
+    real x, xm1, l0, lb, lf, dith;
+    real v_pre[VPLANE], v_e0ap[VPLANE], v_rc1[VPLANE], v_e0[VPLANE], v_eb[VPLANE], v_ef[VPLANE], v_rf[VPLANE], v_rb[VPLANE];
+    integer v_zc[VPLANE];
 
     /*       Arguments */
     /*       Local variables that need not be saved */
@@ -161,14 +183,6 @@ static real c_b2 = 1.f;
     /* Function Body */
     lp_rms__ = 0.f;
     ap_rms__ = 0.f;
-    e_pre__ = 0.f;
-    e0ap = 0.f;
-    *rc1 = 0.f;
-    e_0__ = 0.f;
-    e_b__ = 0.f;
-    e_f__ = 0.f;
-    r_f__ = 0.f;
-    r_b__ = 0.f;
     *zc = 0;
     vlen = vwin[2] - vwin[1] + 1;
     start = vwin[1] + (*half - 1) * vlen / 2 + 1;
@@ -187,35 +201,65 @@ static real c_b2 = 1.f;
     /* VWIN(1)+VLEN = VWIN(2)+1.  That could be bad, if that index of INBUF */
     /* is undefined. */
 
-    r__1 = inbuf[start - 1] - *dither;
-    oldsgn = r_sign(&c_b2, &r__1);
-    i__1 = stop;
-    for (i__ = start; i__ <= i__1; ++i__) {
-        lp_rms__ += (r__1 = lpbuf[i__], abs(r__1));
-        ap_rms__ += (r__1 = inbuf[i__], abs(r__1));
-        e_pre__ += (r__1 = inbuf[i__] - inbuf[i__ - 1], abs(r__1));
-        /* Computing 2nd power */
-        r__1 = inbuf[i__];
-        e0ap += r__1 * r__1;
-        *rc1 += inbuf[i__] * inbuf[i__ - 1];
-        /* Computing 2nd power */
-        r__1 = lpbuf[i__];
-        e_0__ += r__1 * r__1;
-        /* Computing 2nd power */
-        r__1 = lpbuf[i__ - *mintau];
-        e_b__ += r__1 * r__1;
-        /* Computing 2nd power */
-        r__1 = lpbuf[i__ + *mintau];
-        e_f__ += r__1 * r__1;
-        r_f__ += lpbuf[i__] * lpbuf[i__ + *mintau];
-        r_b__ += lpbuf[i__] * lpbuf[i__ - *mintau];
-        r__1 = inbuf[i__] + *dither;
-        if (r_sign(&c_b2, &r__1) != oldsgn) {
-            ++(*zc);
-            oldsgn = -oldsgn;
+    /* The energy and correlation sums are kept in VPLANE partial sums, */
+    /* one per lane, so that the loop below has no dependency between */
+    /* consecutive samples and can be evaluated VPLANE samples at a time. */
+    /* The DITHER sign alternates from sample to sample, starting with */
+    /* -DITHER at START-1, so sample I is compared against the previous */
+    /* one as INBUF(I)+D and INBUF(I-1)-D, with D = +-DITHER.  A zero */
+    /* crossing is counted whenever the two sign tests differ, which is */
+    /* exactly when the sign flip of the original loop happened. */
+
+    for (k = 0; k < VPLANE; ++k) {
+        v_pre[k] = 0.f;
+        v_e0ap[k] = 0.f;
+        v_rc1[k] = 0.f;
+        v_e0[k] = 0.f;
+        v_eb[k] = 0.f;
+        v_ef[k] = 0.f;
+        v_rf[k] = 0.f;
+        v_rb[k] = 0.f;
+        v_zc[k] = 0;
+    }
+    n = stop - start + 1;
+    for (i__ = 0; i__ + VPLANE <= n; i__ += VPLANE) {
+        for (k = 0; k < VPLANE; ++k) {
+            VPACC(k, start + i__ + k, ((i__ + k) & 1) ? -(*dither) : *dither);
         }
+    }
+    for (; i__ < n; ++i__) {
+        VPACC(0, start + i__, (i__ & 1) ? -(*dither) : *dither);
+    }
+    e_pre__ = 0.f;
+    e0ap = 0.f;
+    *rc1 = 0.f;
+    e_0__ = 0.f;
+    e_b__ = 0.f;
+    e_f__ = 0.f;
+    r_f__ = 0.f;
+    r_b__ = 0.f;
+    for (k = 0; k < VPLANE; ++k) {
+        e_pre__ += v_pre[k];
+        e0ap += v_e0ap[k];
+        *rc1 += v_rc1[k];
+        e_0__ += v_e0[k];
+        e_b__ += v_eb[k];
+        e_f__ += v_ef[k];
+        r_f__ += v_rf[k];
+        r_b__ += v_rb[k];
+        *zc += v_zc[k];
+    }
+    if (n & 1) {
         *dither = -(*dither);
     }
+
+    /* LBE and FBE are rounded to integers below, so the magnitude sums */
+    /* are accumulated in the original order to round exactly as before. */
+
+    for (i__ = start; i__ <= stop; ++i__) {
+        lp_rms__ += (r__1 = lpbuf[i__], abs(r__1));
+        ap_rms__ += (r__1 = inbuf[i__], abs(r__1));
+    }
     /*   Normalized short-term autocovariance coefficient at unit sample delay
      */
     *rc1 /= max(e0ap, 1.f);
@@ -1,5 +1,12 @@
 #include "gstlpc10enc.h"
 #include "gstlpc10dec.h"
+#include "gstlpc10parse.h"
+#include "gstlpc10quant.h"
+#include "gstlpc10dequant.h"
+#include "gstlpc10typefind.h"
+#include "gstrtplpc10pay.h"
+#include "gstrtplpc10depay.h"
+#include "gstlpc10tracer.h"
 #include <gst/gst.h>
 #include "version.h"
 
@@ -15,12 +22,36 @@ GST_DEBUG_CATEGORY_STATIC(gst_lpc10_debug_category);
 static gboolean plugin_init(GstPlugin* plugin) {
     GST_DEBUG_CATEGORY_INIT(gst_lpc10_debug_category, "lpc10", 0, "LPC10 plugin");
 
-    if (!gst_element_register(plugin, "lpc10enc", GST_RANK_NONE, GST_TYPE_LPC10_ENC))
+    if (!gst_element_register(plugin, "lpc10enc", GST_RANK_PRIMARY, GST_TYPE_LPC10_ENC))
         return FALSE;
 
-    if (!gst_element_register(plugin, "lpc10dec", GST_RANK_NONE, GST_TYPE_LPC10_DEC))
+    if (!gst_element_register(plugin, "lpc10dec", GST_RANK_PRIMARY, GST_TYPE_LPC10_DEC))
         return FALSE;
 
+    if (!gst_element_register(plugin, "lpc10parse", GST_RANK_PRIMARY, GST_TYPE_LPC10_PARSE))
+        return FALSE;
+
+    // The codec's middle stages, only ever put in a pipeline by hand: decodebin has no use for them
+    if (!gst_element_register(plugin, "lpc10quant", GST_RANK_NONE, GST_TYPE_LPC10_QUANT))
+        return FALSE;
+
+    if (!gst_element_register(plugin, "lpc10dequant", GST_RANK_NONE, GST_TYPE_LPC10_DEQUANT))
+        return FALSE;
+
+    if (!gst_lpc10_typefind_register(plugin))
+        return FALSE;
+
+    if (!gst_element_register(plugin, "rtplpc10pay", GST_RANK_SECONDARY, GST_TYPE_RTP_LPC10_PAY))
+        return FALSE;
+
+    if (!gst_element_register(plugin, "rtplpc10depay", GST_RANK_SECONDARY, GST_TYPE_RTP_LPC10_DEPAY))
+        return FALSE;
+
+#ifdef GST_LPC10_HAVE_TRACER
+    if (!gst_tracer_register(plugin, "lpc10", GST_TYPE_LPC10_TRACER))
+        return FALSE;
+#endif
+
     return TRUE;
 }
 
@@ -28,7 +59,7 @@ static gboolean plugin_init(GstPlugin* plugin) {
 GST_PLUGIN_DEFINE(GST_VERSION_MAJOR,
                   GST_VERSION_MINOR,
                   lpc10,
-                  "LPC10 encoder and decoder",
+                  "LPC10 encoder, decoder, quantizer stages, parser, typefinders, RTP payloaders and tracer",
                   plugin_init,
                   VERSION,
                   "LGPL",
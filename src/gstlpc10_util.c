@@ -40,30 +40,52 @@ void float_to_s16le(const real* in, gint16* out, int num_samples) {
     }
 }
 
+/* Bit <-> byte spreading. Each bit of the LPC10 bitstream is one gint32 (0 or 1)
+ * on the codec side, and bits are stored least significant bit first. Eight bits
+ * are handled at once as a 64-bit word holding one 0/1 value per byte:
+ *  - spread_lut[b] has bit k of b in byte k, so unpacking a byte is one lookup.
+ *  - Packing gathers eight 0/1 values into such a word; multiplying it by
+ *    GATHER_MAGIC moves byte k to bit 56 + k without carries, so the packed
+ *    byte is the top byte of the product. */
+#define GATHER_MAGIC 0x0102040810204080ull
+
+#define SPREAD(b)                                                                                                  \
+    ((guint64)((b) & 1) | (guint64)(((b) >> 1) & 1) << 8 | (guint64)(((b) >> 2) & 1) << 16 |                       \
+     (guint64)(((b) >> 3) & 1) << 24 | (guint64)(((b) >> 4) & 1) << 32 | (guint64)(((b) >> 5) & 1) << 40 |        \
+     (guint64)(((b) >> 6) & 1) << 48 | (guint64)(((b) >> 7) & 1) << 56)
+#define SPREAD4(b) SPREAD(b), SPREAD((b) + 1), SPREAD((b) + 2), SPREAD((b) + 3)
+#define SPREAD16(b) SPREAD4(b), SPREAD4((b) + 4), SPREAD4((b) + 8), SPREAD4((b) + 12)
+#define SPREAD64(b) SPREAD16(b), SPREAD16((b) + 16), SPREAD16((b) + 32), SPREAD16((b) + 48)
+
+static const guint64 spread_lut[256] = {SPREAD64(0), SPREAD64(64), SPREAD64(128), SPREAD64(192)};
+
 /**
  * @brief Packs an array of bits (stored as 0 or 1 in gint32) into a byte array.
  *
  * Based on analysis of lpc10/chanwr.c. The bits are packed sequentially
- * into bytes, least significant bit first within each byte.
+ * into bytes, least significant bit first within each byte. Unused bits of
+ * the last byte are cleared.
  *
  * @param bits_in Input array of bits (0 or 1).
  * @param bytes_out Output byte array.
  * @param num_bits The number of bits to pack.
  */
 void pack_bits(const gint32* bits_in, guint8* bytes_out, int num_bits) {
-    g_assert(num_bits % 8 == 6);                         // LPC10_BITS_IN_COMPRESSED_FRAME is 54
-    int num_bytes = num_bits / 8 + (num_bits % 8 != 0);  // 54 bits = 7 bytes
+    int i;
 
-    for (int i = 0; i < num_bytes; ++i) {
-        bytes_out[i] = 0;
+    for (i = 0; i + 8 <= num_bits; i += 8) {
+        guint64 v = 0;
         for (int j = 0; j < 8; ++j) {
-            int bit_index = i * 8 + j;
-            if (bit_index < num_bits) {
-                if (bits_in[bit_index] & 1) {
-                    bytes_out[i] |= (1 << j);
-                }
-            }
+            v |= (guint64)(bits_in[i + j] & 1) << (8 * j);
+        }
+        bytes_out[i / 8] = (guint8)((v * GATHER_MAGIC) >> 56);
+    }
+    if (i < num_bits) {
+        guint8 last = 0;
+        for (int j = 0; i + j < num_bits; ++j) {
+            last |= (guint8)((bits_in[i + j] & 1) << j);
         }
+        bytes_out[i / 8] = last;
     }
 }
 
@@ -78,15 +100,235 @@ void pack_bits(const gint32* bits_in, guint8* bytes_out, int num_bits) {
  * @param num_bits The number of bits to unpack.
  */
 void unpack_bits(const guint8* bytes_in, gint32* bits_out, int num_bits) {
-    g_assert(num_bits % 8 == 6);                         // LPC10_BITS_IN_COMPRESSED_FRAME is 54
-    int num_bytes = num_bits / 8 + (num_bits % 8 != 0);  // 54 bits = 7 bytes
+    int i;
 
-    for (int i = 0; i < num_bytes; ++i) {
+    for (i = 0; i + 8 <= num_bits; i += 8) {
+        guint64 v = spread_lut[bytes_in[i / 8]];
         for (int j = 0; j < 8; ++j) {
-            int bit_index = i * 8 + j;
-            if (bit_index < num_bits) {
-                bits_out[bit_index] = (bytes_in[i] >> j) & 1;
+            bits_out[i + j] = (gint32)((v >> (8 * j)) & 1);
+        }
+    }
+    for (int j = 0; i + j < num_bits; ++j) {
+        bits_out[i + j] = (bytes_in[i / 8] >> j) & 1;
+    }
+}
+
+/**
+ * @brief Packs whole LPC10 frames into the bytes of an application/x-lpc10 stream.
+ *
+ * With GST_LPC10_PACKING_BYTE each frame takes GST_LPC10_FRAME_BYTES bytes and the
+ * last 2 bits of each are zero. With GST_LPC10_PACKING_TIGHT the frames are one
+ * continuous bitstream, so every GST_LPC10_TIGHT_FRAMES frames take exactly
+ * GST_LPC10_TIGHT_BYTES bytes; num_frames must be a multiple of GST_LPC10_TIGHT_FRAMES.
+ *
+ * @param bits_in LPC10_BITS_IN_COMPRESSED_FRAME bits per frame, as from lpc10_encode().
+ * @param bytes_out Output, num_frames / GST_LPC10_PACKING_FRAMES(packing) * GST_LPC10_PACKING_BYTES(packing) bytes.
+ * @param num_frames The number of frames to pack.
+ * @param packing The stream's packing.
+ */
+void gst_lpc10_pack_frames(const gint32* bits_in, guint8* bytes_out, int num_frames, GstLpc10Packing packing) {
+    if (packing == GST_LPC10_PACKING_TIGHT) {
+        g_assert(num_frames % GST_LPC10_TIGHT_FRAMES == 0);
+        pack_bits(bits_in, bytes_out, num_frames * LPC10_BITS_IN_COMPRESSED_FRAME);
+        return;
+    }
+    for (int i = 0; i < num_frames; ++i) {
+        pack_bits(bits_in + i * LPC10_BITS_IN_COMPRESSED_FRAME, bytes_out + i * GST_LPC10_FRAME_BYTES,
+                  LPC10_BITS_IN_COMPRESSED_FRAME);
+    }
+}
+
+/**
+ * @brief Unpacks whole LPC10 frames from the bytes of an application/x-lpc10 stream.
+ *
+ * The inverse of gst_lpc10_pack_frames().
+ *
+ * @param bytes_in Input, num_frames / GST_LPC10_PACKING_FRAMES(packing) * GST_LPC10_PACKING_BYTES(packing) bytes.
+ * @param bits_out LPC10_BITS_IN_COMPRESSED_FRAME bits per frame, for lpc10_decode().
+ * @param num_frames The number of frames to unpack.
+ * @param packing The stream's packing.
+ */
+void gst_lpc10_unpack_frames(const guint8* bytes_in, gint32* bits_out, int num_frames, GstLpc10Packing packing) {
+    if (packing == GST_LPC10_PACKING_TIGHT) {
+        g_assert(num_frames % GST_LPC10_TIGHT_FRAMES == 0);
+        unpack_bits(bytes_in, bits_out, num_frames * LPC10_BITS_IN_COMPRESSED_FRAME);
+        return;
+    }
+    for (int i = 0; i < num_frames; ++i) {
+        unpack_bits(bytes_in + i * GST_LPC10_FRAME_BYTES, bits_out + i * LPC10_BITS_IN_COMPRESSED_FRAME,
+                    LPC10_BITS_IN_COMPRESSED_FRAME);
+    }
+}
+
+/**
+ * @brief Reads the packing of an application/x-lpc10 caps structure.
+ *
+ * @param s The caps structure.
+ * @return GST_LPC10_PACKING_TIGHT for packing=tight, otherwise GST_LPC10_PACKING_BYTE.
+ */
+GstLpc10Packing gst_lpc10_packing_from_structure(const GstStructure* s) {
+    const gchar* packing = gst_structure_get_string(s, "packing");
+
+    if (packing && g_str_equal(packing, "tight"))
+        return GST_LPC10_PACKING_TIGHT;
+    return GST_LPC10_PACKING_BYTE;
+}
+
+/**
+ * @brief Creates fixed application/x-lpc10 caps for a packing.
+ *
+ * @param packing The packing.
+ * @return New caps, to be unreffed by the caller.
+ */
+GstCaps* gst_lpc10_caps_new(GstLpc10Packing packing) {
+    if (packing == GST_LPC10_PACKING_TIGHT) {
+        return gst_caps_new_simple("application/x-lpc10", "framerate", GST_TYPE_FRACTION, 8000, LPC10_SAMPLES_PER_FRAME,
+                                   "frame-size", G_TYPE_INT, GST_LPC10_TIGHT_BYTES, "packing", G_TYPE_STRING, "tight", NULL);
+    }
+    return gst_caps_new_simple("application/x-lpc10", "framerate", GST_TYPE_FRACTION, 8000, LPC10_SAMPLES_PER_FRAME,
+                               "frame-size", G_TYPE_INT, GST_LPC10_FRAME_BYTES, NULL);
+}
+
+/**
+ * @brief Creates the application/x-lpc10 caps accepted by lpc10enc and lpc10dec:
+ * 7-byte frames, optionally marked packing=byte, or packing=tight.
+ *
+ * @return New caps, to be unreffed by the caller.
+ */
+GstCaps* gst_lpc10_caps_new_template(void) {
+    GstCaps* caps = gst_lpc10_caps_new(GST_LPC10_PACKING_BYTE);
+
+    gst_caps_append(caps, gst_lpc10_caps_new(GST_LPC10_PACKING_TIGHT));
+    return caps;
+}
+
+GstCaps* gst_lpc10_params_caps_new(void) {
+    return gst_caps_new_simple(GST_LPC10_PARAMS_MEDIA_TYPE, "framerate", GST_TYPE_FRACTION, 8000, LPC10_SAMPLES_PER_FRAME,
+                               "frame-size", G_TYPE_INT, GST_LPC10_PARAMS_BYTES, NULL);
+}
+
+GstEvent* gst_lpc10_decoder_state_event_new(GstBuffer* state) {
+    GstStructure* s = gst_structure_new(GST_LPC10_DECODER_STATE_EVENT, "state", GST_TYPE_BUFFER, state, NULL);
+
+    return gst_event_new_custom(GST_EVENT_CUSTOM_DOWNSTREAM, s);
+}
+
+gboolean gst_lpc10_decoder_state_event_restore(GstEvent* event, struct lpc10_decoder_state* st) {
+    const GstStructure* s = gst_event_get_structure(event);
+    const GValue* v = s ? gst_structure_get_value(s, "state") : NULL;
+    GstBuffer* state = v && G_VALUE_HOLDS(v, GST_TYPE_BUFFER) ? gst_value_get_buffer(v) : NULL;
+    GstMapInfo map;
+    gboolean ok;
+
+    if (!state || !gst_buffer_map(state, &map, GST_MAP_READ))
+        return FALSE;
+    ok = lpc10_decoder_state_restore(st, map.data, (int)MIN(map.size, G_MAXINT)) == (int)map.size;
+    gst_buffer_unmap(state, &map);
+    return ok;
+}
+
+/* Timing histograms. Times below 4 ns get a bucket each; above, each power of two is
+ * split into four buckets by the two bits below the leading one, which keeps the
+ * bucket width within 25% of its lower end. */
+static guint gst_lpc10_stats_bucket(guint64 ns) {
+    guint e;
+
+    if (ns < 4)
+        return (guint)ns;
+    e = g_bit_storage(ns) - 1;
+    return MIN(4 * (e - 1) + ((ns >> (e - 2)) & 3), GST_LPC10_STATS_BUCKETS - 1);
+}
+
+static guint64 gst_lpc10_stats_bucket_end(guint bucket) {
+    guint e = bucket / 4 + 1;
+
+    if (bucket < 4)
+        return bucket;
+    return ((guint64)(5 + bucket % 4) << (e - 2)) - 1;
+}
+
+/**
+ * @brief Clears all statistics, e.g. when the element starts.
+ *
+ * @param stats The statistics.
+ */
+void gst_lpc10_stats_reset(GstLpc10Stats* stats) {
+    atomic_store_explicit(&stats->frames, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->allocations, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->fast_path, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->ham_corrected, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->ham_uncorrected, 0, memory_order_relaxed);
+    for (int i = 0; i <= GST_LPC10_STATS_STAGES; ++i) {
+        atomic_store_explicit(&stats->sum_ns[i], 0, memory_order_relaxed);
+        atomic_store_explicit(&stats->max_ns[i], 0, memory_order_relaxed);
+        for (int j = 0; j < GST_LPC10_STATS_BUCKETS; ++j)
+            atomic_store_explicit(&stats->hist[i][j], 0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Counts one frame and records how long its stages took.
+ *
+ * @param stats The statistics.
+ * @param stage_ns Time spent in each of the GST_LPC10_STATS_STAGES stages, in nanoseconds.
+ */
+void gst_lpc10_stats_add_frame(GstLpc10Stats* stats, const guint64 stage_ns[GST_LPC10_STATS_STAGES]) {
+    guint64 ns[GST_LPC10_STATS_STAGES + 1];
+
+    ns[0] = 0;
+    for (int i = 0; i < GST_LPC10_STATS_STAGES; ++i) {
+        ns[i + 1] = stage_ns[i];
+        ns[0] += stage_ns[i];
+    }
+    for (int i = 0; i <= GST_LPC10_STATS_STAGES; ++i) {
+        gst_lpc10_stats_add(&stats->sum_ns[i], ns[i]);
+        gst_lpc10_stats_add(&stats->hist[i][gst_lpc10_stats_bucket(ns[i])], 1);
+        if (ns[i] > atomic_load_explicit(&stats->max_ns[i], memory_order_relaxed))
+            atomic_store_explicit(&stats->max_ns[i], ns[i], memory_order_relaxed);
+    }
+    gst_lpc10_stats_add(&stats->frames, 1);
+}
+
+/**
+ * @brief Creates a snapshot of the statistics.
+ *
+ * @param stats The statistics.
+ * @param name The structure name.
+ * @param stage_names The names of the GST_LPC10_STATS_STAGES stages.
+ * @return A new structure, to be freed by the caller.
+ */
+GstStructure* gst_lpc10_stats_to_structure(GstLpc10Stats* stats, const gchar* name,
+                                           const gchar* const stage_names[GST_LPC10_STATS_STAGES]) {
+    guint64 frames = atomic_load_explicit(&stats->frames, memory_order_relaxed);
+    GstStructure* s = gst_structure_new(name, "frames", G_TYPE_UINT64, frames, "allocations", G_TYPE_UINT64,
+                                        atomic_load_explicit(&stats->allocations, memory_order_relaxed), NULL);
+
+    for (int i = 0; i <= GST_LPC10_STATS_STAGES; ++i) {
+        const gchar* stage = i == 0 ? "frame" : stage_names[i - 1];
+        guint64 max = atomic_load_explicit(&stats->max_ns[i], memory_order_relaxed);
+        guint64 count = 0, p99 = 0, total = 0;
+        gchar *mean_field, *p99_field, *max_field;
+
+        // The histogram may be a few frames ahead of or behind "frames"
+        for (int j = 0; j < GST_LPC10_STATS_BUCKETS; ++j)
+            total += atomic_load_explicit(&stats->hist[i][j], memory_order_relaxed);
+        for (int j = 0; j < GST_LPC10_STATS_BUCKETS && total > 0; ++j) {
+            count += atomic_load_explicit(&stats->hist[i][j], memory_order_relaxed);
+            if (count * 100 >= total * 99) {
+                p99 = MIN(gst_lpc10_stats_bucket_end(j), max);
+                break;
             }
         }
+
+        mean_field = g_strdup_printf("%s-mean-ns", stage);
+        p99_field = g_strdup_printf("%s-p99-ns", stage);
+        max_field = g_strdup_printf("%s-max-ns", stage);
+        gst_structure_set(s, mean_field, G_TYPE_UINT64,
+                          frames ? atomic_load_explicit(&stats->sum_ns[i], memory_order_relaxed) / frames : 0,
+                          p99_field, G_TYPE_UINT64, p99, max_field, G_TYPE_UINT64, max, NULL);
+        g_free(mean_field);
+        g_free(p99_field);
+        g_free(max_field);
     }
+    return s;
 }
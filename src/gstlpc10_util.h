@@ -2,10 +2,43 @@
 #define __GST_LPC10_UTIL_H__
 
 #include <gst/gst.h>
+#include <stdatomic.h>
 #include "lpc10.h"  // For real type and constants (included from lpc10 dir)
 
 G_BEGIN_DECLS
 
+/** Size in bytes of one 54-bit frame in an application/x-lpc10 stream (7 bytes). */
+#define GST_LPC10_FRAME_BYTES ((LPC10_BITS_IN_COMPRESSED_FRAME + 7) / 8)
+
+/** Duration of one frame of LPC10_SAMPLES_PER_FRAME samples at 8 kHz (22.5 ms). */
+#define GST_LPC10_FRAME_DURATION (GST_SECOND * LPC10_SAMPLES_PER_FRAME / 8000)
+
+/**
+ * RMS (as computed by energy_, roughly 1000 * input RMS) at or below which an unvoiced frame is silence to
+ * lpc10enc's DTX, about -45 dBFS. It encodes to a decoded RMS of at most 5, so it holds after decoding too.
+ */
+#define GST_LPC10_DTX_RMS_THRESHOLD 6.0f
+
+/** Number of frames in one block of a packing=tight stream. */
+#define GST_LPC10_TIGHT_FRAMES 4
+
+/** Size in bytes of one block of a packing=tight stream: 4 * 54 bits, no padding (27 bytes). */
+#define GST_LPC10_TIGHT_BYTES (GST_LPC10_TIGHT_FRAMES * LPC10_BITS_IN_COMPRESSED_FRAME / 8)
+
+/**
+ * @brief Layout of frames in an application/x-lpc10 stream, from the "packing" caps field.
+ */
+typedef enum {
+    GST_LPC10_PACKING_BYTE,  ///< One frame per GST_LPC10_FRAME_BYTES bytes, 2 padding bits (default)
+    GST_LPC10_PACKING_TIGHT  ///< GST_LPC10_TIGHT_FRAMES frames per GST_LPC10_TIGHT_BYTES bytes, no padding
+} GstLpc10Packing;
+
+/** Number of frames in the smallest unit of a stream with the given packing. */
+#define GST_LPC10_PACKING_FRAMES(packing) ((packing) == GST_LPC10_PACKING_TIGHT ? GST_LPC10_TIGHT_FRAMES : 1)
+
+/** Size in bytes of the smallest unit of a stream with the given packing (the caps "frame-size"). */
+#define GST_LPC10_PACKING_BYTES(packing) ((packing) == GST_LPC10_PACKING_TIGHT ? GST_LPC10_TIGHT_BYTES : GST_LPC10_FRAME_BYTES)
+
 /**
  * @brief Converts an array of S16_LE samples to an array of float samples.
  *
@@ -42,6 +75,166 @@ void pack_bits(const gint32* bits_in, guint8* bytes_out, int num_bits);
  */
 void unpack_bits(const guint8* bytes_in, gint32* bits_out, int num_bits);
 
+/**
+ * @brief Packs whole LPC10 frames into the bytes of an application/x-lpc10 stream.
+ *
+ * @param bits_in LPC10_BITS_IN_COMPRESSED_FRAME bits per frame, as from lpc10_encode().
+ * @param bytes_out Output byte array.
+ * @param num_frames The number of frames to pack, a multiple of GST_LPC10_PACKING_FRAMES(packing).
+ * @param packing The stream's packing.
+ */
+void gst_lpc10_pack_frames(const gint32* bits_in, guint8* bytes_out, int num_frames, GstLpc10Packing packing);
+
+/**
+ * @brief Unpacks whole LPC10 frames from the bytes of an application/x-lpc10 stream.
+ *
+ * @param bytes_in Input byte array.
+ * @param bits_out LPC10_BITS_IN_COMPRESSED_FRAME bits per frame, for lpc10_decode().
+ * @param num_frames The number of frames to unpack, a multiple of GST_LPC10_PACKING_FRAMES(packing).
+ * @param packing The stream's packing.
+ */
+void gst_lpc10_unpack_frames(const guint8* bytes_in, gint32* bits_out, int num_frames, GstLpc10Packing packing);
+
+/**
+ * @brief Reads the packing of an application/x-lpc10 caps structure.
+ *
+ * @param s The caps structure.
+ * @return GST_LPC10_PACKING_TIGHT for packing=tight, otherwise GST_LPC10_PACKING_BYTE.
+ */
+GstLpc10Packing gst_lpc10_packing_from_structure(const GstStructure* s);
+
+/**
+ * @brief Creates fixed application/x-lpc10 caps for a packing.
+ *
+ * @param packing The packing.
+ * @return New caps, to be unreffed by the caller.
+ */
+GstCaps* gst_lpc10_caps_new(GstLpc10Packing packing);
+
+/**
+ * @brief Creates the application/x-lpc10 caps accepted by lpc10enc and lpc10dec.
+ *
+ * @return New caps, to be unreffed by the caller.
+ */
+GstCaps* gst_lpc10_caps_new_template(void);
+
+/** Media type of a stream of frame parameters, between analysis and quantization or dequantization and synthesis. */
+#define GST_LPC10_PARAMS_MEDIA_TYPE "application/x-lpc10-params"
+
+/**
+ * @brief One frame of an application/x-lpc10-params stream: the parameters lpc10_analyze() and
+ * lpc10_dequantize() write, and lpc10_quantize() and lpc10_synthesize() read. Buffers hold whole
+ * frames, in host byte order; the stream is meant for elements of one process, not for storage.
+ *
+ * Parameters from lpc10enc describe the frame LPC10_ENCODER_DELAY frames before the samples they
+ * are timestamped with, as its bitstream does. Those from lpc10dequant are error corrected and
+ * smoothed, and lag the bits they come from by one frame.
+ */
+typedef struct {
+    INT32 voice[2];        ///< Voicing decision of each half frame, 1 if voiced
+    INT32 pitch;           ///< Pitch period in samples
+    real rms;              ///< Frame energy
+    real rc[LPC10_ORDER];  ///< Reflection coefficients of the vocal tract filter
+} GstLpc10Params;
+
+/** Size in bytes of one GstLpc10Params frame (the caps "frame-size"). */
+#define GST_LPC10_PARAMS_BYTES ((gint)sizeof(GstLpc10Params))
+
+/**
+ * @brief Creates fixed application/x-lpc10-params caps.
+ *
+ * @return New caps, to be unreffed by the caller.
+ */
+GstCaps* gst_lpc10_params_caps_new(void);
+
+/** Media type of an LPC-10 file: a stream with sync points and an index, as lpc10-cli -C writes it. */
+#define GST_LPC10_FILE_MEDIA_TYPE "application/x-lpc10-file"
+
+/** Name of the custom downstream event that carries a saved decoder state from lpc10parse to lpc10dec. */
+#define GST_LPC10_DECODER_STATE_EVENT "lpc10-decoder-state"
+
+/**
+ * @brief Creates the event that makes lpc10dec carry on from a saved decoder state.
+ *
+ * @param state The state, as lpc10_decoder_state_save() writes it.
+ * @return A new serialized custom downstream event.
+ */
+GstEvent* gst_lpc10_decoder_state_event_new(GstBuffer* state);
+
+/**
+ * @brief Restores the decoder state a GST_LPC10_DECODER_STATE_EVENT carries.
+ *
+ * @param event The event.
+ * @param st The decoder state to overwrite; left alone on failure.
+ * @return TRUE if the event held a state of this version of the codec.
+ */
+gboolean gst_lpc10_decoder_state_event_restore(GstEvent* event, struct lpc10_decoder_state* st);
+
+/** Number of codec stages a GstLpc10Stats times separately. */
+#define GST_LPC10_STATS_STAGES 3
+
+/** Number of histogram buckets per timed quantity: four per power of two, up to about 8 s. */
+#define GST_LPC10_STATS_BUCKETS 128
+
+/**
+ * @brief Per-stream codec statistics, behind the "stats" property of lpc10enc and lpc10dec.
+ *
+ * Written by the streaming thread only, and read from any thread. Every field is
+ * loaded and stored with relaxed atomics, so that neither side ever takes a lock;
+ * a reader may see the fields of two consecutive frames mixed. Times are in
+ * nanoseconds per frame, index 0 being the whole frame and 1 to
+ * GST_LPC10_STATS_STAGES the stages.
+ */
+typedef struct {
+    _Atomic guint64 frames;           ///< Frames processed
+    _Atomic guint64 allocations;      ///< Buffers allocated
+    _Atomic guint64 fast_path;        ///< Frames that took the codec's fast path
+    _Atomic guint64 ham_corrected;    ///< Hamming protected words corrected by the decoder
+    _Atomic guint64 ham_uncorrected;  ///< Hamming protected words with too many errors to correct
+    _Atomic guint64 sum_ns[GST_LPC10_STATS_STAGES + 1];
+    _Atomic guint64 max_ns[GST_LPC10_STATS_STAGES + 1];
+    _Atomic guint64 hist[GST_LPC10_STATS_STAGES + 1][GST_LPC10_STATS_BUCKETS];
+} GstLpc10Stats;
+
+/**
+ * @brief Adds to a GstLpc10Stats counter. Only the streaming thread may call this.
+ *
+ * @param counter The counter.
+ * @param n The amount to add.
+ */
+static inline void gst_lpc10_stats_add(_Atomic guint64* counter, guint64 n) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+/**
+ * @brief Clears all statistics, e.g. when the element starts.
+ *
+ * @param stats The statistics.
+ */
+void gst_lpc10_stats_reset(GstLpc10Stats* stats);
+
+/**
+ * @brief Counts one frame and records how long its stages took.
+ *
+ * @param stats The statistics.
+ * @param stage_ns Time spent in each of the GST_LPC10_STATS_STAGES stages, in nanoseconds.
+ */
+void gst_lpc10_stats_add_frame(GstLpc10Stats* stats, const guint64 stage_ns[GST_LPC10_STATS_STAGES]);
+
+/**
+ * @brief Creates a snapshot of the statistics: the "frames" and "allocations" counts, and
+ * "<stage>-mean-ns", "<stage>-p99-ns" and "<stage>-max-ns" for the whole "frame" and for
+ * each stage (all G_TYPE_UINT64). The p99 is the upper end of its histogram bucket, at
+ * most 25% above the exact value.
+ *
+ * @param stats The statistics.
+ * @param name The structure name.
+ * @param stage_names The names of the GST_LPC10_STATS_STAGES stages.
+ * @return A new structure, to be freed by the caller.
+ */
+GstStructure* gst_lpc10_stats_to_structure(GstLpc10Stats* stats, const gchar* name,
+                                           const gchar* const stage_names[GST_LPC10_STATS_STAGES]);
+
 G_END_DECLS
 
 #endif /* __GST_LPC10_UTIL_H__ */
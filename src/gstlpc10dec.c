@@ -5,7 +5,7 @@
 #include <gst/audio/gstaudiodecoder.h>
 #include <gst/audio/audio.h>       // General audio utilities
 #include <gst/audio/audio-info.h>  // Explicit for GstAudioInfo functions
-#include <string.h>                // Required for memset
+#include <string.h>                // Required for memset, memcpy
 
 GST_DEBUG_CATEGORY_STATIC(gst_lpc10_dec_debug_category);
 #define GST_CAT_DEFAULT gst_lpc10_dec_debug_category
@@ -15,16 +15,20 @@ GST_DEBUG_CATEGORY_STATIC(gst_lpc10_dec_debug_category);
 #define LPC10_FRAME_SIZE_BYTES ((LPC10_BITS_IN_COMPRESSED_FRAME + 7) / 8)  // 7 bytes
 #define LPC10_SAMPLES_OUT (LPC10_SAMPLES_PER_FRAME)                        // 180 samples
 
+enum { PROP_0, PROP_STATS };
+
 /* Forward declarations for our static functions */
 static void gst_lpc10_dec_init(GstLpc10Dec* dec);
 static void gst_lpc10_dec_class_init(GstLpc10DecClass* klass);
 static void gst_lpc10_dec_dispose(GObject* object);
 static void gst_lpc10_dec_finalize(GObject* object);
+static void gst_lpc10_dec_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec);
 static gboolean gst_lpc10_dec_start(GstAudioDecoder* dec);
 static gboolean gst_lpc10_dec_stop(GstAudioDecoder* dec);
 static gboolean gst_lpc10_dec_set_format(GstAudioDecoder* dec, GstCaps* caps);
 static GstFlowReturn gst_lpc10_dec_parse(GstAudioDecoder* dec, GstAdapter* adapter, gint* offset, gint* length);
 static GstFlowReturn gst_lpc10_dec_handle_frame(GstAudioDecoder* dec, GstBuffer* inbuf);
+static gboolean gst_lpc10_dec_sink_event(GstAudioDecoder* dec, GstEvent* event);
 
 /* GType registration */
 G_DEFINE_TYPE(GstLpc10Dec, gst_lpc10_dec, GST_TYPE_AUDIO_DECODER)
@@ -39,13 +43,22 @@ static void gst_lpc10_dec_class_init(GstLpc10DecClass* klass) {
 
     gobject_class->dispose = gst_lpc10_dec_dispose;
     gobject_class->finalize = gst_lpc10_dec_finalize;
+    gobject_class->get_property = gst_lpc10_dec_get_property;
+
+    g_object_class_install_property(
+        gobject_class, PROP_STATS,
+        g_param_spec_boxed("stats", "Statistics",
+                           "Frames decoded, time per frame (mean, 99th percentile and maximum, in ns) in total and for "
+                           "the unpack, decode and synth stages, buffers allocated, frames synthesized as silence, and "
+                           "Hamming protected words corrected or found uncorrectable",
+                           GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     gst_element_class_set_static_metadata(element_class, "LPC10 Decoder", "Codec/Decoder/Audio", "LPC10 audio decoder",
                                           "Emin xeome@proton.me");
 
-    // Sink pad template: LPC10 bitstream input
-    GstCaps* sink_caps = gst_caps_new_simple("application/x-lpc10", "framerate", GST_TYPE_FRACTION, 8000, LPC10_SAMPLES_PER_FRAME,
-                                             "frame-size", G_TYPE_INT, LPC10_FRAME_SIZE_BYTES, NULL);
+    // Sink pad template: LPC10 bitstream input, 7-byte frames or packing=tight, or the frame parameters
+    GstCaps* sink_caps = gst_lpc10_caps_new_template();
+    gst_caps_append(sink_caps, gst_lpc10_params_caps_new());
     GstPadTemplate* sink_template = gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS, sink_caps);
     gst_element_class_add_pad_template(element_class, sink_template);
     gst_caps_unref(sink_caps);
@@ -62,14 +75,22 @@ static void gst_lpc10_dec_class_init(GstLpc10DecClass* klass) {
     audio_decoder_class->set_format = GST_DEBUG_FUNCPTR(gst_lpc10_dec_set_format);
     audio_decoder_class->parse = GST_DEBUG_FUNCPTR(gst_lpc10_dec_parse);
     audio_decoder_class->handle_frame = GST_DEBUG_FUNCPTR(gst_lpc10_dec_handle_frame);
+    audio_decoder_class->sink_event = GST_DEBUG_FUNCPTR(gst_lpc10_dec_sink_event);
 }
 
 /* Instance initialization function */
 static void gst_lpc10_dec_init(GstLpc10Dec* dec) {
     dec->lpc10_state = NULL;
+    dec->packing = GST_LPC10_PACKING_BYTE;
+    dec->parsed = FALSE;
+    dec->params = FALSE;
     gst_audio_decoder_set_needs_format(GST_AUDIO_DECODER(dec), TRUE);
     gst_audio_decoder_set_use_default_pad_acceptcaps(GST_AUDIO_DECODER(dec), TRUE);
     GST_PAD_SET_ACCEPT_TEMPLATE(GST_AUDIO_DECODER_SINK_PAD(dec));
+
+    // Lost frames are concealed when the "plc" property is enabled
+    gst_audio_decoder_set_plc_aware(GST_AUDIO_DECODER(dec), TRUE);
+    dec->expected_pts = GST_CLOCK_TIME_NONE;
 }
 
 static void gst_lpc10_dec_dispose(GObject* object) {
@@ -88,6 +109,37 @@ static void gst_lpc10_dec_finalize(GObject* object) {
     G_OBJECT_CLASS(gst_lpc10_dec_parent_class)->finalize(object);
 }
 
+/* Bytes of one input block: a GstLpc10Params frame, or the frames of the packing. */
+static guint gst_lpc10_dec_block_bytes(GstLpc10Dec* dec) {
+    return dec->params ? GST_LPC10_PARAMS_BYTES : GST_LPC10_PACKING_BYTES(dec->packing);
+}
+
+/* Snapshot of the statistics for the "stats" property. Lock-free, see GstLpc10Stats. */
+static GstStructure* gst_lpc10_dec_get_stats(GstLpc10Dec* dec) {
+    static const gchar* const stages[GST_LPC10_STATS_STAGES] = {"unpack", "decode", "synth"};
+    GstStructure* s = gst_lpc10_stats_to_structure(&dec->stats, "lpc10dec-stats", stages);
+
+    gst_structure_set(s, "fast-path-frames", G_TYPE_UINT64,
+                      atomic_load_explicit(&dec->stats.fast_path, memory_order_relaxed), "hamming-corrected",
+                      G_TYPE_UINT64, atomic_load_explicit(&dec->stats.ham_corrected, memory_order_relaxed),
+                      "hamming-uncorrectable", G_TYPE_UINT64,
+                      atomic_load_explicit(&dec->stats.ham_uncorrected, memory_order_relaxed), NULL);
+    return s;
+}
+
+static void gst_lpc10_dec_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec) {
+    GstLpc10Dec* dec = GST_LPC10_DEC(object);
+
+    switch (prop_id) {
+        case PROP_STATS:
+            g_value_take_boxed(value, gst_lpc10_dec_get_stats(dec));
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+            break;
+    }
+}
+
 static gboolean gst_lpc10_dec_start(GstAudioDecoder* audio_dec) {
     GstLpc10Dec* dec = GST_LPC10_DEC(audio_dec);
     GST_DEBUG_OBJECT(dec, "start");
@@ -100,6 +152,9 @@ static gboolean gst_lpc10_dec_start(GstAudioDecoder* audio_dec) {
         return FALSE;
     }
     init_lpc10_decoder_state(dec->lpc10_state);
+    dec->have_last_frame = FALSE;
+    gst_lpc10_stats_reset(&dec->stats);
+    dec->expected_pts = GST_CLOCK_TIME_NONE;
     return TRUE;
 }
 
@@ -117,6 +172,7 @@ static gboolean gst_lpc10_dec_set_format(GstAudioDecoder* audio_dec, GstCaps* in
     GstLpc10Dec* dec = GST_LPC10_DEC(audio_dec);
     GstAudioInfo info;
     GstStructure* s;
+    GstClockTime latency;
 
     GST_DEBUG_OBJECT(dec, "Setting format from input caps: %" GST_PTR_FORMAT, (void*)incaps);
 
@@ -125,11 +181,25 @@ static gboolean gst_lpc10_dec_set_format(GstAudioDecoder* audio_dec, GstCaps* in
         GST_ERROR_OBJECT(dec, "Failed to get structure from input caps");
         return FALSE;
     }
-    if (!gst_structure_has_name(s, "application/x-lpc10")) {
-        GST_ERROR_OBJECT(dec, "Invalid input caps name: %s. Expected application/x-lpc10", gst_structure_get_name(s));
+    dec->params = gst_structure_has_name(s, GST_LPC10_PARAMS_MEDIA_TYPE);
+    if (!dec->params && !gst_structure_has_name(s, "application/x-lpc10")) {
+        GST_ERROR_OBJECT(dec, "Invalid input caps name: %s. Expected application/x-lpc10 or %s",
+                         gst_structure_get_name(s), GST_LPC10_PARAMS_MEDIA_TYPE);
         return FALSE;
     }
     // Further validation of incaps fields (framerate, frame-size) can be added if necessary
+    if (dec->params) {
+        // Parameters come one frame per record, any number of records per buffer
+        dec->packing = GST_LPC10_PACKING_BYTE;
+        dec->parsed = TRUE;
+        GST_DEBUG_OBJECT(dec, "input is frame parameters");
+    } else {
+        dec->packing = gst_lpc10_packing_from_structure(s);
+        if (!gst_structure_get_boolean(s, "parsed", &dec->parsed))
+            dec->parsed = FALSE;
+        GST_DEBUG_OBJECT(dec, "input uses %s packing%s", dec->packing == GST_LPC10_PACKING_TIGHT ? "tight" : "byte",
+                         dec->parsed ? ", parsed" : "");
+    }
 
     gst_audio_info_init(&info);
     gst_audio_info_set_format(&info, GST_AUDIO_FORMAT_S16LE, 8000, 1, NULL);
@@ -138,35 +208,132 @@ static gboolean gst_lpc10_dec_set_format(GstAudioDecoder* audio_dec, GstCaps* in
         GST_ERROR_OBJECT(dec, "Failed to set output audio format");
         return FALSE;
     }
+
+    // A frame's speech comes out LPC10_DECODER_DELAY frames after its bits, whatever
+    // the packing: a block is decoded as soon as it has been received. Of those frames
+    // dequantization takes one, so parameters from lpc10dequant have that one behind them.
+    latency = (dec->params ? LPC10_DECODER_DELAY - 1 : LPC10_DECODER_DELAY) * GST_LPC10_FRAME_DURATION;
+    GST_DEBUG_OBJECT(dec, "latency %" GST_TIME_FORMAT, GST_TIME_ARGS(latency));
+    gst_audio_decoder_set_latency(audio_dec, latency, latency);
     GST_DEBUG_OBJECT(dec, "Output format set successfully");
     return TRUE;
 }
 
 static GstFlowReturn gst_lpc10_dec_parse(GstAudioDecoder* audio_dec, GstAdapter* adapter, gint* offset, gint* length) {
+    GstLpc10Dec* dec = GST_LPC10_DEC(audio_dec);
+    guint block_bytes = gst_lpc10_dec_block_bytes(dec);
     guint available_data;
 
     available_data = gst_adapter_available(adapter);
 
-    if (available_data < LPC10_FRAME_SIZE_BYTES) {
-        GST_LOG_OBJECT(audio_dec, "Not enough data, available %u, needed %d", available_data, LPC10_FRAME_SIZE_BYTES);
+    if (available_data < block_bytes) {
+        GST_LOG_OBJECT(audio_dec, "Not enough data, available %u, needed %u", available_data, block_bytes);
         return GST_FLOW_EOS;  // GstAudioDecoder handles this based on upstream EOS
     }
 
+    // Parsed input already comes in whole blocks, many per buffer: it is taken as it is
     *offset = 0;
-    *length = LPC10_FRAME_SIZE_BYTES;
+    *length = dec->parsed ? available_data / block_bytes * block_bytes : block_bytes;
 
-    GST_LOG_OBJECT(audio_dec, "Parsed one frame, length %d", *length);
+    GST_LOG_OBJECT(audio_dec, "Parsed %u blocks, length %d", *length / block_bytes, *length);
     return GST_FLOW_OK;
 }
 
+/* Packet loss concealment: synthesizes the frames covered by an empty input buffer,
+ * which GstAudioDecoder hands us for GAP events when the "plc" property is set. As
+ * lpc10_conceal() documents, the frame received last before the gap comes out after
+ * the concealed frames, with the first frame received after it. */
+static GstFlowReturn gst_lpc10_dec_conceal(GstLpc10Dec* dec, GstBuffer* inbuf) {
+    GstAudioDecoder* audio_dec = GST_AUDIO_DECODER(dec);
+    GstClockTime frame_duration = gst_util_uint64_scale_int(LPC10_SAMPLES_OUT, GST_SECOND, 8000);
+    real speech_float[LPC10_SAMPLES_OUT];
+    GstBuffer* outbuf;
+    GstMapInfo out_map;
+    guint nframes = 1;
+
+    if (GST_BUFFER_DURATION_IS_VALID(inbuf))
+        nframes = (GST_BUFFER_DURATION(inbuf) + frame_duration / 2) / frame_duration;
+    if (nframes == 0)
+        return gst_audio_decoder_finish_frame(audio_dec, NULL, 1);
+
+    GST_DEBUG_OBJECT(dec, "concealing %u lost frames at %" GST_TIME_FORMAT, nframes, GST_TIME_ARGS(GST_BUFFER_PTS(inbuf)));
+
+    outbuf = gst_buffer_new_allocate(NULL, nframes * LPC10_SAMPLES_OUT * sizeof(gint16), NULL);
+    if (!outbuf || !gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
+        GST_ERROR_OBJECT(dec, "Failed to allocate concealment buffer");
+        if (outbuf)
+            gst_buffer_unref(outbuf);
+        return GST_FLOW_ERROR;
+    }
+    for (guint i = 0; i < nframes; ++i) {
+        lpc10_conceal(speech_float, dec->lpc10_state);
+        lpc10_speech_to_s16(speech_float, (gint16*)out_map.data + i * LPC10_SAMPLES_OUT, LPC10_SAMPLES_OUT);
+    }
+    gst_buffer_unmap(outbuf, &out_map);
+
+    return gst_audio_decoder_finish_frame(audio_dec, outbuf, 1);
+}
+
+/* Whether a 7-byte packed frame is a silence descriptor, as lpc10enc sends during the pauses of
+ * DTX: unvoiced, and at or below GST_LPC10_DTX_RMS_THRESHOLD. It is dequantized twice on a scratch
+ * state, as each frame comes out one frame late, smoothed against its neighbours: here itself, as
+ * in a gap filled with it. */
+static gboolean gst_lpc10_dec_frame_is_sid(const guint8* frame) {
+    struct lpc10_decoder_state st;
+    INT32 bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+    INT32 voice[2], pitch;
+    real rms, rc[LPC10_ORDER];
+
+    init_lpc10_decoder_state(&st);
+    for (guint i = 0; i < 2; ++i) {
+        gst_lpc10_unpack_frames(frame, bits, 1, GST_LPC10_PACKING_BYTE);
+        lpc10_dequantize(bits, voice, &pitch, &rms, rc, &st);
+    }
+    return !voice[0] && !voice[1] && rms <= GST_LPC10_DTX_RMS_THRESHOLD;
+}
+
+/* Frames lost upstream without a GAP event: how many the timestamp of inbuf, holding
+ * nframes frames, jumps ahead of where the previous input ended (typically a buffer
+ * flagged DISCONT). Input without a timestamp carries on from the previous one. With
+ * "plc" set the lost frames are concealed ahead of inbuf's, in the same output buffer,
+ * so inbuf's timestamp is moved back to where they began: the base class stamps the
+ * output with it. */
+static guint gst_lpc10_dec_lost_frames(GstLpc10Dec* dec, GstBuffer* inbuf, guint nframes) {
+    GstClockTime frame_duration = gst_util_uint64_scale_int(LPC10_SAMPLES_OUT, GST_SECOND, 8000);
+    GstClockTime pts = GST_BUFFER_PTS(inbuf);
+    guint nlost = 0;
+
+    if (!GST_CLOCK_TIME_IS_VALID(pts)) {
+        if (GST_CLOCK_TIME_IS_VALID(dec->expected_pts))
+            dec->expected_pts += nframes * frame_duration;
+        return 0;
+    }
+
+    if (GST_CLOCK_TIME_IS_VALID(dec->expected_pts) && pts > dec->expected_pts + frame_duration / 2 &&
+        gst_audio_decoder_get_plc(GST_AUDIO_DECODER(dec)) && gst_buffer_is_writable(inbuf)) {
+        nlost = (pts - dec->expected_pts + frame_duration / 2) / frame_duration;
+        GST_DEBUG_OBJECT(dec, "timestamp jump from %" GST_TIME_FORMAT " to %" GST_TIME_FORMAT ", concealing %u frames",
+                         GST_TIME_ARGS(dec->expected_pts), GST_TIME_ARGS(pts), nlost);
+        GST_BUFFER_PTS(inbuf) = dec->expected_pts;
+    }
+    dec->expected_pts = pts + nframes * frame_duration;
+    return nlost;
+}
+
 static GstFlowReturn gst_lpc10_dec_handle_frame(GstAudioDecoder* audio_dec, GstBuffer* inbuf) {
     GstLpc10Dec* dec = GST_LPC10_DEC(audio_dec);
     GstMapInfo in_map, out_map;
-    const guint8* in_data;
     gint16* out_data_s16;
     real speech_float[LPC10_SAMPLES_OUT];
-    INT32 lpc10_bits[LPC10_BITS_IN_COMPRESSED_FRAME];
-    gint i;
+    INT32 lpc10_bits[GST_LPC10_TIGHT_FRAMES * LPC10_BITS_IN_COMPRESSED_FRAME];
+    INT32 voice[2], pitch;
+    real rms, rc[LPC10_ORDER];
+    guint block_frames = GST_LPC10_PACKING_FRAMES(dec->packing);
+    guint block_bytes = gst_lpc10_dec_block_bytes(dec);
+    GstLpc10Params params;
+    guint64 stage_ns[GST_LPC10_STATS_STAGES];
+    GstClockTime t0, t1, t2;
+    guint i, b, nblocks, nlost;
     GstBuffer* outbuf;
     GstFlowReturn ret = GST_FLOW_OK;
 
@@ -175,35 +342,28 @@ static GstFlowReturn gst_lpc10_dec_handle_frame(GstAudioDecoder* audio_dec, GstB
         return GST_FLOW_EOS;  // Let GstAudioDecoder base class handle EOS finalization
     }
 
+    // An empty buffer is the base class asking for concealment of a gap
+    if (gst_buffer_get_size(inbuf) == 0) {
+        return gst_lpc10_dec_conceal(dec, inbuf);
+    }
+
     if (!gst_buffer_map(inbuf, &in_map, GST_MAP_READ)) {
         GST_ERROR_OBJECT(dec, "Failed to map input buffer");
         return GST_FLOW_ERROR;
     }
 
-    if (in_map.size < LPC10_FRAME_SIZE_BYTES) {
-        GST_ERROR_OBJECT(dec, "Input buffer too small: %" G_GSIZE_FORMAT " bytes, expected %d", in_map.size,
-                         LPC10_FRAME_SIZE_BYTES);
+    if (in_map.size < block_bytes) {
+        GST_ERROR_OBJECT(dec, "Input buffer too small: %" G_GSIZE_FORMAT " bytes, expected %u", in_map.size, block_bytes);
         gst_buffer_unmap(inbuf, &in_map);
         return GST_FLOW_ERROR;
     }
-    in_data = (const guint8*)in_map.data;
 
-    // Unpack the 54 bits from the 7-byte input buffer into the INT32 array.
-    for (i = 0; i < LPC10_BITS_IN_COMPRESSED_FRAME; ++i) {
-        int byte_index = i / 8;
-        int bit_index_in_byte = i % 8;
-        if ((in_data[byte_index] >> bit_index_in_byte) & 1) {
-            lpc10_bits[i] = 1;
-        } else {
-            lpc10_bits[i] = 0;
-        }
-    }
-
-    // Call the LPC10 decode function
-    lpc10_decode(lpc10_bits, speech_float, dec->lpc10_state);
+    // One block, or with parsed input as many as the buffer holds
+    nblocks = in_map.size / block_bytes;
+    nlost = gst_lpc10_dec_lost_frames(dec, inbuf, nblocks * block_frames);
 
     // Allocate output buffer
-    outbuf = gst_buffer_new_allocate(NULL, LPC10_SAMPLES_OUT * sizeof(gint16), NULL);
+    outbuf = gst_buffer_new_allocate(NULL, (nlost + nblocks * block_frames) * LPC10_SAMPLES_OUT * sizeof(gint16), NULL);
     if (!outbuf) {
         GST_ERROR_OBJECT(dec, "Failed to allocate output buffer");
         gst_buffer_unmap(inbuf, &in_map);
@@ -212,25 +372,171 @@ static GstFlowReturn gst_lpc10_dec_handle_frame(GstAudioDecoder* audio_dec, GstB
 
     if (!gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
         GST_ERROR_OBJECT(dec, "Failed to map output buffer");
-        gst_buffer_unmap(inbuf, &in_map);
         gst_buffer_unref(outbuf);
+        gst_buffer_unmap(inbuf, &in_map);
         return GST_FLOW_ERROR;
     }
-    out_data_s16 = (gint16*)out_map.data;
+    gst_lpc10_stats_add(&dec->stats.allocations, 1);
+
+    // The lost frames come first, then those of inbuf
+    for (i = 0; i < nlost; ++i) {
+        lpc10_conceal(speech_float, dec->lpc10_state);
+        lpc10_speech_to_s16(speech_float, (gint16*)out_map.data + i * LPC10_SAMPLES_OUT, LPC10_SAMPLES_OUT);
+    }
+    out_data_s16 = (gint16*)out_map.data + nlost * LPC10_SAMPLES_OUT;
+
+    for (b = 0; b < nblocks && dec->params; ++b) {
+        // Parameters are only synthesized; synthesis clamps them in place, so a copy is handed over
+        memcpy(&params, in_map.data + b * block_bytes, sizeof(params));
+        t0 = gst_util_get_timestamp();
+        lpc10_synthesize(params.voice, &params.pitch, &params.rms, params.rc, speech_float, dec->lpc10_state);
+        dec->lpc10_state->nlost = 0;  // As lpc10_dequantize() does: concealment fades from this frame on
+        lpc10_speech_to_s16(speech_float, out_data_s16 + b * LPC10_SAMPLES_OUT, LPC10_SAMPLES_OUT);
+        t1 = gst_util_get_timestamp();
+
+        stage_ns[0] = stage_ns[1] = 0;
+        stage_ns[2] = t1 - t0;
+        gst_lpc10_stats_add_frame(&dec->stats, stage_ns);
+        gst_lpc10_stats_add(&dec->stats.fast_path, dec->lpc10_state->silent != 0);
+    }
 
-    // Convert LPC10 real (float) output to S16_LE format
-    for (i = 0; i < LPC10_SAMPLES_OUT; ++i) {
-        real val = speech_float[i] * 32768.0f;
-        if (val > 32767.0f)
-            val = 32767.0f;
-        else if (val < -32768.0f)
-            val = -32768.0f;
-        out_data_s16[i] = (gint16)val;
+    for (b = 0; b < nblocks && !dec->params; ++b) {
+        // Unpack the 54 bits of each frame (7 bytes each, or 4 frames in 27 bytes) into the INT32 array.
+        // The block is unpacked at once; each of its frames is charged an equal share.
+        t0 = gst_util_get_timestamp();
+        gst_lpc10_unpack_frames(in_map.data + b * block_bytes, lpc10_bits, block_frames, dec->packing);
+        t1 = gst_util_get_timestamp();
+        stage_ns[0] = (t1 - t0) / block_frames;
+
+        for (i = 0; i < block_frames; ++i) {
+            // lpc10_decode() in its two stages, timed separately
+            t0 = gst_util_get_timestamp();
+            lpc10_dequantize(lpc10_bits + i * LPC10_BITS_IN_COMPRESSED_FRAME, voice, &pitch, &rms, rc,
+                             dec->lpc10_state);
+            t1 = gst_util_get_timestamp();
+            lpc10_synthesize(voice, &pitch, &rms, rc, speech_float, dec->lpc10_state);
+
+            lpc10_speech_to_s16(speech_float, out_data_s16 + (b * block_frames + i) * LPC10_SAMPLES_OUT,
+                                LPC10_SAMPLES_OUT);
+            t2 = gst_util_get_timestamp();
+
+            stage_ns[1] = t1 - t0;
+            stage_ns[2] = t2 - t1;
+            gst_lpc10_stats_add_frame(&dec->stats, stage_ns);
+            gst_lpc10_stats_add(&dec->stats.fast_path, dec->lpc10_state->silent != 0);
+            gst_lpc10_stats_add(&dec->stats.ham_corrected, dec->lpc10_state->hamfix);
+            gst_lpc10_stats_add(&dec->stats.ham_uncorrected, dec->lpc10_state->hambad);
+        }
+    }
+
+    // Keep the last frame of the last block for comfort noise, and whether it can be used as such.
+    // There are no bits to keep of parameters: their gaps are left to the base class, or to
+    // concealment with "plc".
+    if (!dec->params) {
+        gst_lpc10_pack_frames(lpc10_bits + (block_frames - 1) * LPC10_BITS_IN_COMPRESSED_FRAME, dec->last_frame, 1,
+                              GST_LPC10_PACKING_BYTE);
+        dec->have_last_frame = TRUE;
+        dec->last_frame_is_sid = gst_lpc10_dec_frame_is_sid(dec->last_frame);
     }
 
     gst_buffer_unmap(inbuf, &in_map);
     gst_buffer_unmap(outbuf, &out_map);
 
-    ret = gst_audio_decoder_finish_frame(audio_dec, outbuf, 1);  // 1 frame processed
+    ret = gst_audio_decoder_finish_frame(audio_dec, outbuf, 1);  // 1 frame: what parse handed over
     return ret;
 }
+
+/* Fills a GAP event with comfort noise. With DTX the encoder only pauses during
+ * silence and the last frame it sent is a silence descriptor, so decoding that
+ * frame again for the length of the gap reproduces the background noise level and
+ * spectrum, and keeps the synthesis state running. Any other frame, e.g. the voiced
+ * one before a gap in the stream, would only buzz for its length: such gaps are
+ * left to the base class. */
+static gboolean gst_lpc10_dec_fill_gap(GstLpc10Dec* dec, GstEvent* event) {
+    GstClockTime frame_duration = gst_util_uint64_scale_int(LPC10_SAMPLES_OUT, GST_SECOND, 8000);
+    GstClockTime block_duration = GST_LPC10_PACKING_FRAMES(dec->packing) * frame_duration;
+    guint block_bytes = GST_LPC10_PACKING_BYTES(dec->packing);
+    guint8 block[GST_LPC10_TIGHT_BYTES];
+    GstClockTime timestamp, duration;
+    GstBuffer* buf;
+    GstMapInfo map;
+    guint nblocks = 1;
+
+    if (!dec->have_last_frame)
+        return FALSE;
+    if (!dec->last_frame_is_sid) {
+        GST_LOG_OBJECT(dec, "last frame is not a silence descriptor, leaving the gap to the base class");
+        return FALSE;
+    }
+
+    gst_event_parse_gap(event, &timestamp, &duration);
+    if (GST_CLOCK_TIME_IS_VALID(duration))
+        nblocks = MAX(1, (duration + block_duration / 2) / block_duration);
+
+    // The gap is filled in the stream's own packing, in whole blocks
+    if (dec->packing == GST_LPC10_PACKING_TIGHT) {
+        INT32 bits[GST_LPC10_TIGHT_FRAMES * LPC10_BITS_IN_COMPRESSED_FRAME];
+
+        for (guint i = 0; i < GST_LPC10_TIGHT_FRAMES; ++i)
+            gst_lpc10_unpack_frames(dec->last_frame, bits + i * LPC10_BITS_IN_COMPRESSED_FRAME, 1, GST_LPC10_PACKING_BYTE);
+        gst_lpc10_pack_frames(bits, block, GST_LPC10_TIGHT_FRAMES, GST_LPC10_PACKING_TIGHT);
+    } else {
+        memcpy(block, dec->last_frame, LPC10_FRAME_SIZE_BYTES);
+    }
+
+    buf = gst_buffer_new_allocate(NULL, nblocks * block_bytes, NULL);
+    if (!buf || !gst_buffer_map(buf, &map, GST_MAP_WRITE)) {
+        if (buf)
+            gst_buffer_unref(buf);
+        return FALSE;
+    }
+    for (guint i = 0; i < nblocks; ++i)
+        memcpy(map.data + i * block_bytes, block, block_bytes);
+    gst_buffer_unmap(buf, &map);
+
+    GST_BUFFER_PTS(buf) = timestamp;
+    GST_BUFFER_DURATION(buf) = nblocks * block_duration;
+
+    GST_LOG_OBJECT(dec, "filling gap at %" GST_TIME_FORMAT " with %u comfort noise frames", GST_TIME_ARGS(timestamp),
+                   nblocks * GST_LPC10_PACKING_FRAMES(dec->packing));
+    gst_pad_chain(GST_AUDIO_DECODER_SINK_PAD(dec), buf);
+    return TRUE;
+}
+
+static gboolean gst_lpc10_dec_sink_event(GstAudioDecoder* audio_dec, GstEvent* event) {
+    GstLpc10Dec* dec = GST_LPC10_DEC(audio_dec);
+
+    switch (GST_EVENT_TYPE(event)) {
+        case GST_EVENT_GAP: {
+            GstClockTime timestamp, duration;
+
+            gst_event_parse_gap(event, &timestamp, &duration);
+            if (GST_CLOCK_TIME_IS_VALID(timestamp) && GST_CLOCK_TIME_IS_VALID(duration))
+                dec->expected_pts = timestamp + duration;
+
+            // With "plc" set the base class hands gaps to handle_frame for concealment
+            if (!gst_audio_decoder_get_plc(audio_dec) && gst_lpc10_dec_fill_gap(dec, event)) {
+                gst_event_unref(event);
+                return TRUE;
+            }
+            break;
+        }
+        case GST_EVENT_FLUSH_STOP:
+        case GST_EVENT_SEGMENT:
+            dec->have_last_frame = FALSE;
+            dec->expected_pts = GST_CLOCK_TIME_NONE;
+            break;
+        case GST_EVENT_CUSTOM_DOWNSTREAM:
+            // lpc10parse, after a seek: the state at the sync point its next frames follow
+            if (gst_event_has_name(event, GST_LPC10_DECODER_STATE_EVENT)) {
+                if (dec->lpc10_state && !gst_lpc10_decoder_state_event_restore(event, dec->lpc10_state))
+                    GST_WARNING_OBJECT(dec, "Ignoring a decoder state that does not restore");
+                gst_event_unref(event);
+                return TRUE;
+            }
+            break;
+        default:
+            break;
+    }
+    return GST_AUDIO_DECODER_CLASS(gst_lpc10_dec_parent_class)->sink_event(audio_dec, event);
+}
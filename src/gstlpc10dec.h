@@ -6,6 +6,7 @@
 #include <gst/audio/gstaudiodecoder.h>  // Changed from gstbasetransform.h
 #include <gst/gstbuffer.h>              // Include for GstBuffer
 #include "lpc10.h"                      // Corrected include path
+#include "gstlpc10_util.h"
 
 G_BEGIN_DECLS
 
@@ -32,6 +33,19 @@ struct _GstLpc10Dec {
     GstClockTime current_input_timestamp;   // Store the timestamp of the current input buffer
     GstClockTime current_output_timestamp;  // Store/calculate the timestamp for the next output buffer
 
+    GstLpc10Packing packing;  // Input packing, from the sink caps
+    gboolean parsed;          // Input framed upstream (parsed=true, e.g. from lpc10parse): buffers are whole blocks
+    gboolean params;          // Input is frame parameters (application/x-lpc10-params): synthesis only
+
+    // Last frame received (always 7-byte packed), re-decoded as comfort noise across DTX gaps
+    guint8 last_frame[(LPC10_BITS_IN_COMPRESSED_FRAME + 7) / 8];
+    gboolean have_last_frame;
+    gboolean last_frame_is_sid;  // The last frame is a silence descriptor (unvoiced, quiet): gaps are filled with it
+
+    GstClockTime expected_pts;  // Timestamp the next input buffer should have, to detect lost frames
+
+    GstLpc10Stats stats;  // "stats" property; fast_path counts the frames synths_ took the silence path for
+
     // Add other instance variables here as needed
 };
 
@@ -0,0 +1,199 @@
+#include "gstlpc10dequant.h"
+#include "gstlpc10_util.h"
+#include "lpc10.h"
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+#include <string.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_lpc10_dequant_debug_category);
+#define GST_CAT_DEFAULT gst_lpc10_dequant_debug_category
+
+#include "gstlpc10_macros.h"
+
+/* Forward declarations for our static functions */
+GST_LPC10_BASE_TRANSFORM_PROTOTYPES(Dequant, dequant)
+static gboolean gst_lpc10_dequant_transform_size(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                                 gsize size, GstCaps* othercaps, gsize* othersize);
+static gboolean gst_lpc10_dequant_sink_event(GstBaseTransform* trans, GstEvent* event);
+static gboolean gst_lpc10_dequant_query(GstBaseTransform* trans, GstPadDirection direction, GstQuery* query);
+
+/* GType registration */
+G_DEFINE_TYPE(GstLpc10Dequant, gst_lpc10_dequant, GST_TYPE_BASE_TRANSFORM)
+
+/* Class initialization function */
+static void gst_lpc10_dequant_class_init(GstLpc10DequantClass* klass) {
+    GstElementClass* element_class = GST_ELEMENT_CLASS(klass);
+    GST_LPC10_BASE_TRANSFORM_ASSIGN(klass, dequant)
+
+    GST_DEBUG_CATEGORY_INIT(gst_lpc10_dequant_debug_category, "lpc10dequant", 0, "LPC10 dequantizer element");
+
+    base_transform_class->transform_size = GST_DEBUG_FUNCPTR(gst_lpc10_dequant_transform_size);
+    base_transform_class->sink_event = GST_DEBUG_FUNCPTR(gst_lpc10_dequant_sink_event);
+    base_transform_class->query = GST_DEBUG_FUNCPTR(gst_lpc10_dequant_query);
+
+    gst_element_class_set_static_metadata(element_class, "LPC10 Dequantizer", "Codec/Decoder/Audio",
+                                          "Decodes LPC10 frames into error corrected, smoothed frame parameters",
+                                          "Emin xeome@proton.me");
+
+    // Sink pad template: LPC10 bitstream input, 7-byte frames or packing=tight
+    GstCaps* sink_caps = gst_lpc10_caps_new_template();
+    GstPadTemplate* sink_template = gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS, sink_caps);
+    gst_element_class_add_pad_template(element_class, sink_template);
+    gst_caps_unref(sink_caps);
+
+    // Source pad template: frame parameters, for lpc10dec to synthesize
+    GstCaps* src_caps = gst_lpc10_params_caps_new();
+    GstPadTemplate* src_template = gst_pad_template_new("src", GST_PAD_SRC, GST_PAD_ALWAYS, src_caps);
+    gst_element_class_add_pad_template(element_class, src_template);
+    gst_caps_unref(src_caps);
+}
+
+/* Instance initialization function */
+static void gst_lpc10_dequant_init(GstLpc10Dequant* dequant) {
+    dequant->lpc10_state = NULL;
+    dequant->packing = GST_LPC10_PACKING_BYTE;
+}
+
+static void gst_lpc10_dequant_dispose(GObject* object) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(object);
+    GST_DEBUG_OBJECT(dequant, "dispose");
+    if (dequant->lpc10_state) {
+        g_free(dequant->lpc10_state);
+        dequant->lpc10_state = NULL;
+    }
+    G_OBJECT_CLASS(gst_lpc10_dequant_parent_class)->dispose(object);
+}
+
+static void gst_lpc10_dequant_finalize(GObject* object) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(object);
+    GST_DEBUG_OBJECT(dequant, "finalize");
+    G_OBJECT_CLASS(gst_lpc10_dequant_parent_class)->finalize(object);
+}
+
+static gboolean gst_lpc10_dequant_start(GstBaseTransform* trans) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(trans);
+    GST_DEBUG_OBJECT(dequant, "start");
+    g_free(dequant->lpc10_state);
+    dequant->lpc10_state = g_malloc0(sizeof(struct lpc10_decoder_state));
+    init_lpc10_decoder_state(dequant->lpc10_state);
+    return TRUE;
+}
+
+static gboolean gst_lpc10_dequant_stop(GstBaseTransform* trans) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(trans);
+    GST_DEBUG_OBJECT(dequant, "stop");
+    if (dequant->lpc10_state) {
+        g_free(dequant->lpc10_state);
+        dequant->lpc10_state = NULL;
+    }
+    return TRUE;
+}
+
+/* LPC10 frames of either packing on the sink pad, parameters on the source pad. */
+static GstCaps* gst_lpc10_dequant_transform_caps(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                                 GstCaps* filter) {
+    GstCaps* othercaps = direction == GST_PAD_SINK ? gst_lpc10_params_caps_new() : gst_lpc10_caps_new_template();
+
+    if (filter) {
+        GstCaps* intersection = gst_caps_intersect_full(filter, othercaps, GST_CAPS_INTERSECT_FIRST);
+
+        gst_caps_unref(othercaps);
+        othercaps = intersection;
+    }
+    return othercaps;
+}
+
+static gboolean gst_lpc10_dequant_set_caps(GstBaseTransform* trans, GstCaps* incaps, GstCaps* outcaps) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(trans);
+
+    dequant->packing = gst_lpc10_packing_from_structure(gst_caps_get_structure(incaps, 0));
+    GST_DEBUG_OBJECT(dequant, "input uses %s packing", dequant->packing == GST_LPC10_PACKING_TIGHT ? "tight" : "byte");
+    return TRUE;
+}
+
+/* One GstLpc10Params record for every frame of the whole blocks of input. */
+static gboolean gst_lpc10_dequant_transform_size(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                                 gsize size, GstCaps* othercaps, gsize* othersize) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(trans);
+    guint block_frames = GST_LPC10_PACKING_FRAMES(dequant->packing);
+    guint block_bytes = GST_LPC10_PACKING_BYTES(dequant->packing);
+
+    if (direction == GST_PAD_SINK)
+        *othersize = size / block_bytes * block_frames * GST_LPC10_PARAMS_BYTES;
+    else
+        *othersize = size / (block_frames * GST_LPC10_PARAMS_BYTES) * block_bytes;
+    return TRUE;
+}
+
+static GstFlowReturn gst_lpc10_dequant_transform(GstBaseTransform* trans, GstBuffer* inbuf, GstBuffer* outbuf) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(trans);
+    INT32 lpc10_bits[GST_LPC10_TIGHT_FRAMES * LPC10_BITS_IN_COMPRESSED_FRAME];
+    guint block_frames = GST_LPC10_PACKING_FRAMES(dequant->packing);
+    guint block_bytes = GST_LPC10_PACKING_BYTES(dequant->packing);
+    GstLpc10Params params;
+    GstMapInfo in_map, out_map;
+    guint i, b, nblocks;
+    guint8* out;
+
+    if (!gst_buffer_map(inbuf, &in_map, GST_MAP_READ)) {
+        GST_ERROR_OBJECT(dequant, "Failed to map input buffer");
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
+        GST_ERROR_OBJECT(dequant, "Failed to map output buffer");
+        gst_buffer_unmap(inbuf, &in_map);
+        return GST_FLOW_ERROR;
+    }
+
+    // Input buffers are whole blocks, as lpc10enc and lpc10parse put them out
+    nblocks = in_map.size / block_bytes;
+    if (in_map.size % block_bytes)
+        GST_WARNING_OBJECT(dequant, "Dropping %" G_GSIZE_FORMAT " bytes short of a block", in_map.size % block_bytes);
+
+    out = out_map.data;
+    for (b = 0; b < nblocks; ++b) {
+        gst_lpc10_unpack_frames(in_map.data + b * block_bytes, lpc10_bits, block_frames, dequant->packing);
+        for (i = 0; i < block_frames; ++i) {
+            lpc10_dequantize(lpc10_bits + i * LPC10_BITS_IN_COMPRESSED_FRAME, params.voice, &params.pitch,
+                             &params.rms, params.rc, dequant->lpc10_state);
+            memcpy(out, &params, sizeof(params));
+            out += GST_LPC10_PARAMS_BYTES;
+        }
+    }
+
+    gst_buffer_unmap(outbuf, &out_map);
+    gst_buffer_unmap(inbuf, &in_map);
+    gst_buffer_set_size(outbuf, nblocks * block_frames * GST_LPC10_PARAMS_BYTES);
+    return GST_FLOW_OK;
+}
+
+static gboolean gst_lpc10_dequant_sink_event(GstBaseTransform* trans, GstEvent* event) {
+    GstLpc10Dequant* dequant = GST_LPC10_DEQUANT(trans);
+
+    // lpc10parse, after a seek: the state at the sync point its next frames follow. It is restored
+    // here for dequantization and passed on, so that lpc10dec restores it for synthesis.
+    if (GST_EVENT_TYPE(event) == GST_EVENT_CUSTOM_DOWNSTREAM &&
+        gst_event_has_name(event, GST_LPC10_DECODER_STATE_EVENT) && dequant->lpc10_state &&
+        !gst_lpc10_decoder_state_event_restore(event, dequant->lpc10_state))
+        GST_WARNING_OBJECT(dequant, "Ignoring a decoder state that does not restore");
+
+    return GST_BASE_TRANSFORM_CLASS(gst_lpc10_dequant_parent_class)->sink_event(trans, event);
+}
+
+/* Dequantization holds each frame's parameters back one frame: that is added to the latency. */
+static gboolean gst_lpc10_dequant_query(GstBaseTransform* trans, GstPadDirection direction, GstQuery* query) {
+    GstClockTime min, max;
+    gboolean live;
+
+    if (!GST_BASE_TRANSFORM_CLASS(gst_lpc10_dequant_parent_class)->query(trans, direction, query))
+        return FALSE;
+
+    if (direction == GST_PAD_SRC && GST_QUERY_TYPE(query) == GST_QUERY_LATENCY) {
+        gst_query_parse_latency(query, &live, &min, &max);
+        min += GST_LPC10_FRAME_DURATION;
+        if (GST_CLOCK_TIME_IS_VALID(max))
+            max += GST_LPC10_FRAME_DURATION;
+        gst_query_set_latency(query, live, min, max);
+    }
+    return TRUE;
+}
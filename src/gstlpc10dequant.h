@@ -0,0 +1,36 @@
+#ifndef __GST_LPC10_DEQUANT_H__
+#define __GST_LPC10_DEQUANT_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+#include "lpc10.h"
+#include "gstlpc10_util.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_LPC10_DEQUANT (gst_lpc10_dequant_get_type())
+#define GST_LPC10_DEQUANT(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_LPC10_DEQUANT, GstLpc10Dequant))
+#define GST_LPC10_DEQUANT_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_LPC10_DEQUANT, GstLpc10DequantClass))
+#define GST_IS_LPC10_DEQUANT(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_LPC10_DEQUANT))
+#define GST_IS_LPC10_DEQUANT_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_LPC10_DEQUANT))
+
+typedef struct _GstLpc10Dequant GstLpc10Dequant;
+typedef struct _GstLpc10DequantClass GstLpc10DequantClass;
+
+/* The dequantizer stage of lpc10dec on its own: LPC10 frames in, application/x-lpc10-params out. */
+struct _GstLpc10Dequant {
+    GstBaseTransform parent;
+
+    struct lpc10_decoder_state* lpc10_state;  // Only the decode_ part of it is used by lpc10_dequantize()
+    GstLpc10Packing packing;                  // Input packing, from the sink caps
+};
+
+struct _GstLpc10DequantClass {
+    GstBaseTransformClass parent_class;
+};
+
+GType gst_lpc10_dequant_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_LPC10_DEQUANT_H__ */
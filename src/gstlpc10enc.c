@@ -12,6 +12,16 @@ GST_DEBUG_CATEGORY_STATIC(gst_lpc10_enc_debug_category);
 
 #include "gstlpc10_macros.h"  // Include macros header
 
+/* Discontinuous transmission. A frame is active when analys_ voiced either half
+ * of it, or its RMS is above GST_LPC10_DTX_RMS_THRESHOLD. */
+#define LPC10_DTX_HANGOVER 6       // Frames still sent after the last active frame (135 ms)
+#define LPC10_DTX_SID_INTERVAL 8   // A silence descriptor frame is sent every 8 frames (180 ms)
+
+#define DEFAULT_DTX FALSE
+#define DEFAULT_LOW_DELAY FALSE
+
+enum { PROP_0, PROP_DTX, PROP_LOW_DELAY, PROP_STATS };
+
 /* Define GstLpc10Enc private structure if G_ADD_PRIVATE is used,
  * or ensure GstLpc10Enc itself in gstlpc10enc.h has the members.
  * For simplicity here, we assume members are directly in GstLpc10Enc.
@@ -27,10 +37,13 @@ static void gst_lpc10_enc_init(GstLpc10Enc* enc);
 static void gst_lpc10_enc_class_init(GstLpc10EncClass* klass);
 static void gst_lpc10_enc_dispose(GObject* object);
 static void gst_lpc10_enc_finalize(GObject* object);  // Added for completeness
+static void gst_lpc10_enc_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec);
+static void gst_lpc10_enc_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec);
 static gboolean gst_lpc10_enc_start(GstAudioEncoder* enc);
 static gboolean gst_lpc10_enc_stop(GstAudioEncoder* enc);
 static gboolean gst_lpc10_enc_set_format(GstAudioEncoder* enc, GstAudioInfo* info);
 static GstFlowReturn gst_lpc10_enc_handle_frame(GstAudioEncoder* enc, GstBuffer* buffer);
+static GstFlowReturn gst_lpc10_enc_pre_push(GstAudioEncoder* enc, GstBuffer** buffer);
 
 /* GType registration */
 G_DEFINE_TYPE(GstLpc10Enc, gst_lpc10_enc, GST_TYPE_AUDIO_ENCODER)
@@ -45,6 +58,28 @@ static void gst_lpc10_enc_class_init(GstLpc10EncClass* klass) {
 
     gobject_class->dispose = gst_lpc10_enc_dispose;
     gobject_class->finalize = gst_lpc10_enc_finalize;
+    gobject_class->set_property = gst_lpc10_enc_set_property;
+    gobject_class->get_property = gst_lpc10_enc_get_property;
+
+    g_object_class_install_property(
+        gobject_class, PROP_DTX,
+        g_param_spec_boolean("dtx", "DTX",
+                             "Discontinuous transmission: stop sending frames during silence, mark the pauses with "
+                             "GAP events and send a silence descriptor frame every " G_STRINGIFY(LPC10_DTX_SID_INTERVAL)
+                             " frames",
+                             DEFAULT_DTX, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+    g_object_class_install_property(
+        gobject_class, PROP_LOW_DELAY,
+        g_param_spec_boolean("low-delay", "Low delay",
+                             "Send each frame one frame (22.5 ms) earlier, with one frame less look-ahead for the voicing "
+                             "and pitch decisions, which makes voicing and pitch errors somewhat more frequent",
+                             DEFAULT_LOW_DELAY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+    g_object_class_install_property(
+        gobject_class, PROP_STATS,
+        g_param_spec_boxed("stats", "Statistics",
+                           "Frames encoded, time per frame (mean, 99th percentile and maximum, in ns) in total and "
+                           "for the analysis, quantize and pack stages, buffers allocated, and frames not sent by DTX",
+                           GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
     gst_element_class_set_static_metadata(element_class, "LPC10 Encoder", "Codec/Encoder/Audio", "LPC10 audio encoder",
                                           "Emin xeome@proton.me");
@@ -56,9 +91,9 @@ static void gst_lpc10_enc_class_init(GstLpc10EncClass* klass) {
     gst_element_class_add_pad_template(element_class, sink_template);
     gst_caps_unref(sink_caps);
 
-    // Source pad template: LPC10 bitstream output
-    GstCaps* src_caps = gst_caps_new_simple("application/x-lpc10", "framerate", GST_TYPE_FRACTION, 8000, LPC10_SAMPLES_PER_FRAME,
-                                            "frame-size", G_TYPE_INT, (LPC10_BITS_IN_COMPRESSED_FRAME + 7) / 8, NULL);
+    // Source pad template: LPC10 bitstream output, 7-byte frames or packing=tight, or the frame parameters
+    GstCaps* src_caps = gst_lpc10_caps_new_template();
+    gst_caps_append(src_caps, gst_lpc10_params_caps_new());
     GstPadTemplate* src_template = gst_pad_template_new("src", GST_PAD_SRC, GST_PAD_ALWAYS, src_caps);
     gst_element_class_add_pad_template(element_class, src_template);
     gst_caps_unref(src_caps);
@@ -67,16 +102,17 @@ static void gst_lpc10_enc_class_init(GstLpc10EncClass* klass) {
     audio_encoder_class->stop = GST_DEBUG_FUNCPTR(gst_lpc10_enc_stop);
     audio_encoder_class->set_format = GST_DEBUG_FUNCPTR(gst_lpc10_enc_set_format);
     audio_encoder_class->handle_frame = GST_DEBUG_FUNCPTR(gst_lpc10_enc_handle_frame);
-
-    // Set latency based on one frame
-    // gst_audio_encoder_class_set_max_latency(audio_encoder_class,
-    //                                         gst_util_uint64_scale_int(LPC10_SAMPLES_PER_FRAME, GST_SECOND, 8000));
+    audio_encoder_class->pre_push = GST_DEBUG_FUNCPTR(gst_lpc10_enc_pre_push);
 }
 
 /* Instance initialization function */
 static void gst_lpc10_enc_init(GstLpc10Enc* enc) {
     // GstLpc10Enc *enc = GST_LPC10_ENC (self); // Not needed with G_DEFINE_TYPE direct init
     enc->lpc10_state = NULL;
+    enc->dtx = DEFAULT_DTX;
+    enc->low_delay = DEFAULT_LOW_DELAY;
+    enc->packing = GST_LPC10_PACKING_BYTE;
+    enc->params = FALSE;
     // Set sink pad to accept template caps by default
     GST_PAD_SET_ACCEPT_TEMPLATE(GST_AUDIO_ENCODER_SINK_PAD(enc));
 }
@@ -93,6 +129,59 @@ static void gst_lpc10_enc_dispose(GObject* object) {
     G_OBJECT_CLASS(gst_lpc10_enc_parent_class)->dispose(object);
 }
 
+static void gst_lpc10_enc_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec) {
+    GstLpc10Enc* enc = GST_LPC10_ENC(object);
+
+    switch (prop_id) {
+        case PROP_DTX:
+            GST_OBJECT_LOCK(enc);
+            enc->dtx = g_value_get_boolean(value);
+            GST_OBJECT_UNLOCK(enc);
+            break;
+        case PROP_LOW_DELAY:
+            GST_OBJECT_LOCK(enc);
+            enc->low_delay = g_value_get_boolean(value);
+            GST_OBJECT_UNLOCK(enc);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+            break;
+    }
+}
+
+/* Snapshot of the statistics for the "stats" property. Lock-free, see GstLpc10Stats. */
+static GstStructure* gst_lpc10_enc_get_stats(GstLpc10Enc* enc) {
+    static const gchar* const stages[GST_LPC10_STATS_STAGES] = {"analysis", "quantize", "pack"};
+    GstStructure* s = gst_lpc10_stats_to_structure(&enc->stats, "lpc10enc-stats", stages);
+
+    gst_structure_set(s, "dtx-frames", G_TYPE_UINT64, atomic_load_explicit(&enc->stats.fast_path, memory_order_relaxed),
+                      NULL);
+    return s;
+}
+
+static void gst_lpc10_enc_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec) {
+    GstLpc10Enc* enc = GST_LPC10_ENC(object);
+
+    switch (prop_id) {
+        case PROP_DTX:
+            GST_OBJECT_LOCK(enc);
+            g_value_set_boolean(value, enc->dtx);
+            GST_OBJECT_UNLOCK(enc);
+            break;
+        case PROP_LOW_DELAY:
+            GST_OBJECT_LOCK(enc);
+            g_value_set_boolean(value, enc->low_delay);
+            GST_OBJECT_UNLOCK(enc);
+            break;
+        case PROP_STATS:
+            g_value_take_boxed(value, gst_lpc10_enc_get_stats(enc));
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+            break;
+    }
+}
+
 // Finalize function
 static void gst_lpc10_enc_finalize(GObject* object) {
     GstLpc10Enc* enc = GST_LPC10_ENC(object);
@@ -118,6 +207,13 @@ static gboolean gst_lpc10_enc_start(GstAudioEncoder* audio_enc) {
         return FALSE;
     }
     init_lpc10_encoder_state(enc->lpc10_state);
+    enc->latency_valid = FALSE;
+    gst_lpc10_stats_reset(&enc->stats);
+
+    // Always send the first frames so that caps and segment go out before any GAP event
+    enc->dtx_hangover = LPC10_DTX_HANGOVER;
+    enc->dtx_since_sid = 0;
+    enc->dtx_next_pts = GST_CLOCK_TIME_NONE;
     return TRUE;
 }
 
@@ -133,9 +229,35 @@ static gboolean gst_lpc10_enc_stop(GstAudioEncoder* audio_enc) {
     return TRUE;
 }
 
+/* Applies the "low-delay" property to the encoder state and reports the resulting
+ * latency: a frame's bits leave with the output buffer of the block that was read
+ * LPC10_ENCODER_DELAY (or LPC10_ENCODER_LOW_DELAY) frames after it, and that block
+ * is only complete once all of its frames have been received. Called before every
+ * block, so that a property change takes effect on the next one. */
+static void gst_lpc10_enc_update_delay(GstLpc10Enc* enc) {
+    gboolean low_delay;
+    GstClockTime latency;
+
+    GST_OBJECT_LOCK(enc);
+    low_delay = enc->low_delay;
+    GST_OBJECT_UNLOCK(enc);
+
+    if (enc->latency_valid && (enc->lpc10_state->lowdelay != 0) == (low_delay != FALSE))
+        return;
+
+    enc->lpc10_state->lowdelay = low_delay ? 1 : 0;
+    latency = (GST_LPC10_PACKING_FRAMES(enc->packing) + (low_delay ? LPC10_ENCODER_LOW_DELAY : LPC10_ENCODER_DELAY)) *
+              GST_LPC10_FRAME_DURATION;
+    enc->latency_valid = TRUE;
+    GST_DEBUG_OBJECT(enc, "latency %" GST_TIME_FORMAT "%s", GST_TIME_ARGS(latency), low_delay ? " (low delay)" : "");
+    gst_audio_encoder_set_latency(GST_AUDIO_ENCODER(enc), latency, latency);
+}
+
 static gboolean gst_lpc10_enc_set_format(GstAudioEncoder* audio_enc, GstAudioInfo* info) {
     GstLpc10Enc* enc = GST_LPC10_ENC(audio_enc);
+    GstCaps* allowed;
     GstCaps* outcaps;
+    guint block_samples;
 
     GST_DEBUG_OBJECT(enc, "set_format: rate %d, channels %d, format %s", GST_AUDIO_INFO_RATE(info), GST_AUDIO_INFO_CHANNELS(info),
                      gst_audio_format_to_string(GST_AUDIO_INFO_FORMAT(info)));
@@ -156,9 +278,29 @@ static gboolean gst_lpc10_enc_set_format(GstAudioEncoder* audio_enc, GstAudioInf
         return FALSE;
     }
 
+    // Use the packing downstream prefers, 7-byte frames unless it asks for packing=tight, or the
+    // parameters of each frame if it asks for those first
+    enc->packing = GST_LPC10_PACKING_BYTE;
+    enc->params = FALSE;
+    allowed = gst_pad_get_allowed_caps(GST_AUDIO_ENCODER_SRC_PAD(audio_enc));
+    if (allowed) {
+        if (!gst_caps_is_empty(allowed)) {
+            GstStructure* s = gst_caps_get_structure(allowed, 0);
+
+            if (gst_structure_has_name(s, GST_LPC10_PARAMS_MEDIA_TYPE))
+                enc->params = TRUE;
+            else
+                enc->packing = gst_lpc10_packing_from_structure(s);
+        }
+        gst_caps_unref(allowed);
+    }
+    GST_DEBUG_OBJECT(enc, "using %s",
+                     enc->params                                ? "parameter output"
+                     : enc->packing == GST_LPC10_PACKING_TIGHT ? "tight packing"
+                                                                : "byte packing");
+
     // Define output capabilities
-    outcaps = gst_caps_new_simple("application/x-lpc10", "framerate", GST_TYPE_FRACTION, 8000, LPC10_SAMPLES_PER_FRAME,
-                                  "frame-size", G_TYPE_INT, (LPC10_BITS_IN_COMPRESSED_FRAME + 7) / 8, NULL);
+    outcaps = enc->params ? gst_lpc10_params_caps_new() : gst_lpc10_caps_new(enc->packing);
     if (!gst_audio_encoder_set_output_format(audio_enc, outcaps)) {
         gst_caps_unref(outcaps);
         GST_ERROR_OBJECT(enc, "Failed to set output format");
@@ -166,22 +308,92 @@ static gboolean gst_lpc10_enc_set_format(GstAudioEncoder* audio_enc, GstAudioInf
     }
     gst_caps_unref(outcaps);
 
-    // Inform base class about framing
-    gst_audio_encoder_set_frame_samples_min(audio_enc, LPC10_SAMPLES_PER_FRAME);
-    gst_audio_encoder_set_frame_samples_max(audio_enc, LPC10_SAMPLES_PER_FRAME);
-    gst_audio_encoder_set_frame_max(audio_enc, 1);  // Each input frame produces one output buffer
+    // Inform base class about framing: one frame, or one block of frames with packing=tight
+    block_samples = GST_LPC10_PACKING_FRAMES(enc->packing) * LPC10_SAMPLES_PER_FRAME;
+    gst_audio_encoder_set_frame_samples_min(audio_enc, block_samples);
+    gst_audio_encoder_set_frame_samples_max(audio_enc, block_samples);
+    gst_audio_encoder_set_frame_max(audio_enc, 1);  // Each input block produces one output buffer
+
+    // The block size is part of the latency
+    enc->latency_valid = FALSE;
+    gst_lpc10_enc_update_delay(enc);
 
     return TRUE;
 }
 
+/* Voice activity detection on the frame lpc10_encode just returned. analys_ leaves
+ * that frame's voicing decisions in voibuf[2..3] and its RMS in rmsbuf[0], or in
+ * voibuf[4..5] and rmsbuf[1] in low-delay mode. Returns TRUE if DTX is enabled and
+ * the frame should not be sent. */
+static gboolean gst_lpc10_enc_dtx_skip_frame(GstLpc10Enc* enc) {
+    const struct lpc10_encoder_state* st = enc->lpc10_state;
+    const int k = st->lowdelay ? 1 : 0;
+    gboolean dtx;
+
+    GST_OBJECT_LOCK(enc);
+    dtx = enc->dtx;
+    GST_OBJECT_UNLOCK(enc);
+
+    if (st->voibuf[2 * k + 2] || st->voibuf[2 * k + 3] || st->rmsbuf[k] > GST_LPC10_DTX_RMS_THRESHOLD) {
+        enc->dtx_hangover = LPC10_DTX_HANGOVER;
+    } else if (enc->dtx_hangover > 0) {
+        enc->dtx_hangover--;
+    }
+
+    if (!dtx || enc->dtx_hangover > 0 || !GST_CLOCK_TIME_IS_VALID(enc->dtx_next_pts)) {
+        enc->dtx_since_sid = 0;
+        return FALSE;
+    }
+
+    // Inside a pause: refresh the decoder's comfort noise every LPC10_DTX_SID_INTERVAL frames
+    if (++enc->dtx_since_sid >= LPC10_DTX_SID_INTERVAL) {
+        GST_LOG_OBJECT(enc, "sending silence descriptor frame");
+        enc->dtx_since_sid = 0;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Drops the current block of nframes frames (nsamples input samples) and marks its
+ * time span with a GAP event. */
+static GstFlowReturn gst_lpc10_enc_push_gap(GstLpc10Enc* enc, guint nframes, guint nsamples) {
+    GstAudioEncoder* audio_enc = GST_AUDIO_ENCODER(enc);
+    GstClockTime duration = nframes * gst_util_uint64_scale_int(LPC10_SAMPLES_PER_FRAME, GST_SECOND, 8000);
+    GstClockTime pts = enc->dtx_next_pts;
+    GstFlowReturn ret;
+
+    ret = gst_audio_encoder_finish_frame(audio_enc, NULL, nsamples);
+    if (ret != GST_FLOW_OK)
+        return ret;
+
+    GST_LOG_OBJECT(enc, "DTX gap at %" GST_TIME_FORMAT, GST_TIME_ARGS(pts));
+    enc->dtx_next_pts = pts + duration;
+    gst_pad_push_event(GST_AUDIO_ENCODER_SRC_PAD(audio_enc), gst_event_new_gap(pts, duration));
+    return GST_FLOW_OK;
+}
+
+/* Remembers where the next frame starts, so that DTX gaps can be timestamped the
+ * same way GstAudioEncoder timestamps the frames it pushes. */
+static GstFlowReturn gst_lpc10_enc_pre_push(GstAudioEncoder* audio_enc, GstBuffer** buffer) {
+    GstLpc10Enc* enc = GST_LPC10_ENC(audio_enc);
+
+    if (GST_BUFFER_PTS_IS_VALID(*buffer) && GST_BUFFER_DURATION_IS_VALID(*buffer))
+        enc->dtx_next_pts = GST_BUFFER_PTS(*buffer) + GST_BUFFER_DURATION(*buffer);
+    return GST_FLOW_OK;
+}
+
 static GstFlowReturn gst_lpc10_enc_handle_frame(GstAudioEncoder* audio_enc, GstBuffer* inbuf) {
     GstLpc10Enc* enc = GST_LPC10_ENC(audio_enc);
     GstMapInfo in_map, out_map;
-    gint16* in_data;
-    guint8* out_data;
+    const gint16* in_data;
     real speech_float[LPC10_SAMPLES_PER_FRAME];
-    INT32 lpc10_bits[LPC10_BITS_IN_COMPRESSED_FRAME];
-    gint i;
+    INT32 lpc10_bits[GST_LPC10_TIGHT_FRAMES * LPC10_BITS_IN_COMPRESSED_FRAME];
+    GstLpc10Params params[GST_LPC10_TIGHT_FRAMES];
+    guint block_frames = GST_LPC10_PACKING_FRAMES(enc->packing);
+    guint64 stage_ns[GST_LPC10_TIGHT_FRAMES][GST_LPC10_STATS_STAGES];
+    GstClockTime t0, t1, t2;
+    guint nsamples, i;
+    gboolean skip = TRUE;
     GstBuffer* outbuf;
     GstFlowReturn ret = GST_FLOW_OK;
 
@@ -198,55 +410,76 @@ static GstFlowReturn gst_lpc10_enc_handle_frame(GstAudioEncoder* audio_enc, GstB
         return GST_FLOW_ERROR;
     }
 
-    if (in_map.size < (LPC10_SAMPLES_PER_FRAME * sizeof(gint16))) {
-        GST_ERROR_OBJECT(enc, "Input buffer too small: %" G_GSIZE_FORMAT " bytes, expected %d", in_map.size,
-                         (int)(LPC10_SAMPLES_PER_FRAME * sizeof(gint16)));
-        gst_buffer_unmap(inbuf, &in_map);
-        return GST_FLOW_ERROR;  // Or perhaps just drop and ask for more?
+    in_data = (const gint16*)in_map.data;
+    nsamples = in_map.size / sizeof(gint16);
+
+    gst_lpc10_enc_update_delay(enc);
+
+    // Encode each frame of the block. A short block (the rest of the stream at EOS)
+    // is padded with silence.
+    for (i = 0; i < block_frames; ++i) {
+        guint offset = i * LPC10_SAMPLES_PER_FRAME;
+        guint n = nsamples > offset ? MIN(nsamples - offset, LPC10_SAMPLES_PER_FRAME) : 0;
+
+        t0 = gst_util_get_timestamp();
+        s16le_to_float(in_data + offset, speech_float, n);
+        memset(speech_float + n, 0, (LPC10_SAMPLES_PER_FRAME - n) * sizeof(real));
+
+        // lpc10_encode() in its two stages, timed separately; for parameter output only the first
+        lpc10_analyze(speech_float, params[i].voice, &params[i].pitch, &params[i].rms, params[i].rc, enc->lpc10_state);
+        t1 = gst_util_get_timestamp();
+        if (!enc->params)
+            lpc10_quantize(params[i].voice, &params[i].pitch, &params[i].rms, params[i].rc,
+                           lpc10_bits + i * LPC10_BITS_IN_COMPRESSED_FRAME, enc->lpc10_state);
+        t2 = gst_util_get_timestamp();
+        stage_ns[i][0] = t1 - t0;
+        stage_ns[i][1] = t2 - t1;
+        stage_ns[i][2] = 0;
+
+        // A block is only dropped if DTX would drop every frame in it
+        if (!gst_lpc10_enc_dtx_skip_frame(enc))
+            skip = FALSE;
     }
+    gst_buffer_unmap(inbuf, &in_map);
 
-    in_data = (gint16*)in_map.data;
-
-    // Convert S16_LE input to LPC10 real (float) format
-    for (i = 0; i < LPC10_SAMPLES_PER_FRAME; ++i) {
-        speech_float[i] = (real)in_data[i] / 32768.0f;
+    if (skip) {
+        for (i = 0; i < block_frames; ++i)
+            gst_lpc10_stats_add_frame(&enc->stats, stage_ns[i]);
+        gst_lpc10_stats_add(&enc->stats.fast_path, block_frames);
+        return gst_lpc10_enc_push_gap(enc, block_frames, nsamples);
     }
 
-    // Call the LPC10 encode function
-    lpc10_encode(speech_float, lpc10_bits, enc->lpc10_state);
-
-    // Allocate output buffer for 54 bits (7 bytes)
-    outbuf = gst_buffer_new_allocate(NULL, (LPC10_BITS_IN_COMPRESSED_FRAME + 7) / 8, NULL);
+    // Allocate output buffer: 54 bits in 7 bytes, 4 * 54 bits in 27 bytes, or one GstLpc10Params
+    outbuf = gst_buffer_new_allocate(NULL, enc->params ? GST_LPC10_PARAMS_BYTES : GST_LPC10_PACKING_BYTES(enc->packing),
+                                     NULL);
     if (!outbuf) {
         GST_ERROR_OBJECT(enc, "Failed to allocate output buffer");
-        gst_buffer_unmap(inbuf, &in_map);
         return GST_FLOW_ERROR;
     }
 
     if (!gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
         GST_ERROR_OBJECT(enc, "Failed to map output buffer");
-        gst_buffer_unmap(inbuf, &in_map);
         gst_buffer_unref(outbuf);
         return GST_FLOW_ERROR;
     }
-    out_data = (guint8*)out_map.data;
-    memset(out_data, 0, out_map.size);
+    t0 = gst_util_get_timestamp();
+    if (enc->params)
+        memcpy(out_map.data, params, GST_LPC10_PARAMS_BYTES);
+    else
+        gst_lpc10_pack_frames(lpc10_bits, out_map.data, block_frames, enc->packing);
+    t1 = gst_util_get_timestamp();
+    gst_buffer_unmap(outbuf, &out_map);
 
-    // Pack the 54 bits from the INT32 array into the 7-byte output buffer.
-    for (i = 0; i < LPC10_BITS_IN_COMPRESSED_FRAME; ++i) {
-        if (lpc10_bits[i] != 0) {
-            int byte_index = i / 8;
-            int bit_index_in_byte = i % 8;
-            out_data[byte_index] |= (1 << bit_index_in_byte);
-        }
+    // The block is packed at once; each of its frames is charged an equal share
+    for (i = 0; i < block_frames; ++i) {
+        stage_ns[i][2] = (t1 - t0) / block_frames;
+        gst_lpc10_stats_add_frame(&enc->stats, stage_ns[i]);
     }
-
-    gst_buffer_unmap(inbuf, &in_map);
-    gst_buffer_unmap(outbuf, &out_map);
+    gst_lpc10_stats_add(&enc->stats.allocations, 1);
 
     // Timestamps and duration are typically handled by GstAudioEncoder based on
     // input buffer and samples consumed.
-    ret = gst_audio_encoder_finish_frame(audio_enc, outbuf, LPC10_SAMPLES_PER_FRAME);
+    ret = gst_audio_encoder_finish_frame(audio_enc, outbuf, nsamples);
 
     return ret;
 }
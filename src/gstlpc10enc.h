@@ -4,6 +4,7 @@
 #include <gst/gst.h>
 #include <gst/audio/audio.h>
 #include "lpc10.h"  // Corrected include path
+#include "gstlpc10_util.h"
 
 G_BEGIN_DECLS
 
@@ -29,6 +30,21 @@ struct _GstLpc10Enc {
 
     gsize processed_samples;  // Keep track of the total number of samples processed
 
+    GstLpc10Packing packing;  // Output packing, negotiated in set_format
+    gboolean params;          // Output frame parameters (application/x-lpc10-params), not bits, as negotiated
+
+    // Discontinuous transmission
+    gboolean dtx;               // "dtx" property: drop frames while the VAD reports silence
+    guint dtx_hangover;         // Frames still to send after the last active frame
+    guint dtx_since_sid;        // Frames dropped since the last silence descriptor was sent
+    GstClockTime dtx_next_pts;  // Timestamp of the frame after the last pushed buffer
+
+    // Look-ahead
+    gboolean low_delay;      // "low-delay" property: return each frame's bits one frame earlier
+    gboolean latency_valid;  // The latency reported to the base class matches the packing and lowdelay
+
+    GstLpc10Stats stats;  // "stats" property; fast_path counts the frames DTX did not send
+
     // Add other instance variables here as needed
 };
 
@@ -0,0 +1,453 @@
+#include "gstlpc10parse.h"
+#include "gstlpc10_util.h"
+#include "lpc10.h"
+#include <gst/gst.h>
+#include <gst/base/gstbaseparse.h>
+#include <string.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_lpc10_parse_debug_category);
+#define GST_CAT_DEFAULT gst_lpc10_parse_debug_category
+
+// Most frames in one output buffer: about a second, whole tight blocks
+#define GST_LPC10_PARSE_MAX_FRAMES 44
+
+/* Forward declarations for our static functions */
+static void gst_lpc10_parse_init(GstLpc10Parse* parse);
+static void gst_lpc10_parse_class_init(GstLpc10ParseClass* klass);
+static void gst_lpc10_parse_finalize(GObject* object);
+static gboolean gst_lpc10_parse_start(GstBaseParse* base_parse);
+static gboolean gst_lpc10_parse_stop(GstBaseParse* base_parse);
+static gboolean gst_lpc10_parse_set_sink_caps(GstBaseParse* base_parse, GstCaps* caps);
+static GstFlowReturn gst_lpc10_parse_handle_frame(GstBaseParse* base_parse, GstBaseParseFrame* frame, gint* skipsize);
+static GstFlowReturn gst_lpc10_parse_pre_push_frame(GstBaseParse* base_parse, GstBaseParseFrame* frame);
+static gboolean gst_lpc10_parse_convert(GstBaseParse* base_parse, GstFormat src_format, gint64 src_value,
+                                        GstFormat dest_format, gint64* dest_value);
+
+/* GType registration */
+G_DEFINE_TYPE(GstLpc10Parse, gst_lpc10_parse, GST_TYPE_BASE_PARSE)
+
+/* Class initialization function */
+static void gst_lpc10_parse_class_init(GstLpc10ParseClass* klass) {
+    GObjectClass* gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass* element_class = GST_ELEMENT_CLASS(klass);
+    GstBaseParseClass* base_parse_class = GST_BASE_PARSE_CLASS(klass);
+
+    GST_DEBUG_CATEGORY_INIT(gst_lpc10_parse_debug_category, "lpc10parse", 0, "LPC10 parser");
+
+    gobject_class->finalize = gst_lpc10_parse_finalize;
+
+    gst_element_class_set_static_metadata(element_class, "LPC10 Parser", "Codec/Parser/Audio",
+                                          "Frames bare LPC10 streams and LPC-10 files, with duration and seeking",
+                                          "Emin xeome@proton.me");
+
+    // Sink pad template: LPC-10 files, as lpc10-cli -C writes them, and bare streams of either packing
+    GstCaps* sink_caps = gst_caps_new_empty_simple(GST_LPC10_FILE_MEDIA_TYPE);
+    gst_caps_append(sink_caps, gst_caps_new_empty_simple("application/x-lpc10"));
+    GstPadTemplate* sink_template = gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS, sink_caps);
+    gst_element_class_add_pad_template(element_class, sink_template);
+    gst_caps_unref(sink_caps);
+
+    // Source pad template: the LPC10 bitstream, in the packing of the input, parsed=true
+    GstCaps* src_caps = gst_lpc10_caps_new_template();
+    GstPadTemplate* src_template = gst_pad_template_new("src", GST_PAD_SRC, GST_PAD_ALWAYS, src_caps);
+    gst_element_class_add_pad_template(element_class, src_template);
+    gst_caps_unref(src_caps);
+
+    base_parse_class->start = GST_DEBUG_FUNCPTR(gst_lpc10_parse_start);
+    base_parse_class->stop = GST_DEBUG_FUNCPTR(gst_lpc10_parse_stop);
+    base_parse_class->set_sink_caps = GST_DEBUG_FUNCPTR(gst_lpc10_parse_set_sink_caps);
+    base_parse_class->handle_frame = GST_DEBUG_FUNCPTR(gst_lpc10_parse_handle_frame);
+    base_parse_class->pre_push_frame = GST_DEBUG_FUNCPTR(gst_lpc10_parse_pre_push_frame);
+    base_parse_class->convert = GST_DEBUG_FUNCPTR(gst_lpc10_parse_convert);
+}
+
+/* Instance initialization function */
+static void gst_lpc10_parse_init(GstLpc10Parse* parse) {
+    parse->syncs = g_array_new(FALSE, FALSE, sizeof(GstLpc10ParseSync));
+    parse->state = NULL;
+    GST_PAD_SET_ACCEPT_TEMPLATE(GST_BASE_PARSE_SINK_PAD(parse));
+}
+
+static void gst_lpc10_parse_finalize(GObject* object) {
+    GstLpc10Parse* parse = GST_LPC10_PARSE(object);
+
+    g_array_free(parse->syncs, TRUE);
+    gst_buffer_replace(&parse->state, NULL);
+    G_OBJECT_CLASS(gst_lpc10_parse_parent_class)->finalize(object);
+}
+
+static gboolean gst_lpc10_parse_start(GstBaseParse* base_parse) {
+    GstLpc10Parse* parse = GST_LPC10_PARSE(base_parse);
+
+    GST_DEBUG_OBJECT(parse, "start");
+    parse->packing = GST_LPC10_PACKING_BYTE;
+    parse->raw = FALSE;
+    parse->have_header = FALSE;
+    parse->nframes = -1;
+    parse->index_offset = 0;
+    g_array_set_size(parse->syncs, 0);
+    parse->next_offset = 0;
+    parse->synced = FALSE;
+    parse->frame = 0;
+    parse->left = 0;
+    parse->skip = 0;
+    gst_buffer_replace(&parse->state, NULL);
+
+    gst_base_parse_set_min_frame_size(base_parse, LPC10_FILE_HEADER_BYTES);
+    // Every frame is timestamped from its number, also right after a seek
+    gst_base_parse_set_has_timing_info(base_parse, TRUE);
+    return TRUE;
+}
+
+static gboolean gst_lpc10_parse_stop(GstBaseParse* base_parse) {
+    GstLpc10Parse* parse = GST_LPC10_PARSE(base_parse);
+
+    GST_DEBUG_OBJECT(parse, "stop");
+    gst_buffer_replace(&parse->state, NULL);
+    return TRUE;
+}
+
+/* Bare streams say so in their caps. Without caps, e.g. straight from filesrc, the first bytes
+ * tell: a stream without a file header is taken for 7-byte frames. */
+static gboolean gst_lpc10_parse_set_sink_caps(GstBaseParse* base_parse, GstCaps* caps) {
+    GstLpc10Parse* parse = GST_LPC10_PARSE(base_parse);
+    GstStructure* s = gst_caps_get_structure(caps, 0);
+
+    GST_DEBUG_OBJECT(parse, "sink caps %" GST_PTR_FORMAT, (void*)caps);
+    if (gst_structure_has_name(s, "application/x-lpc10")) {
+        parse->raw = TRUE;
+        parse->packing = gst_lpc10_packing_from_structure(s);
+    }
+    return TRUE;
+}
+
+static void gst_lpc10_parse_set_src_caps(GstLpc10Parse* parse) {
+    GstCaps* caps = gst_lpc10_caps_new(parse->packing);
+
+    gst_caps_set_simple(caps, "parsed", G_TYPE_BOOLEAN, TRUE, NULL);
+    gst_pad_set_caps(GST_BASE_PARSE_SRC_PAD(parse), caps);
+    gst_caps_unref(caps);
+}
+
+/* A bare stream: its duration follows from its size, and every block is a place to start at. */
+static void gst_lpc10_parse_start_raw(GstLpc10Parse* parse) {
+    GstBaseParse* base_parse = GST_BASE_PARSE(parse);
+    gint64 bytes, duration;
+
+    parse->raw = TRUE;
+    parse->have_header = TRUE;
+    GST_DEBUG_OBJECT(parse, "bare LPC10 stream, %s packing",
+                     parse->packing == GST_LPC10_PACKING_TIGHT ? "tight" : "byte");
+    gst_lpc10_parse_set_src_caps(parse);
+    gst_base_parse_set_min_frame_size(base_parse, GST_LPC10_PACKING_BYTES(parse->packing));
+    if (gst_pad_peer_query_duration(GST_BASE_PARSE_SINK_PAD(parse), GST_FORMAT_BYTES, &bytes) && bytes >= 0 &&
+        gst_lpc10_parse_convert(base_parse, GST_FORMAT_BYTES, bytes, GST_FORMAT_TIME, &duration))
+        gst_base_parse_set_duration(base_parse, GST_FORMAT_TIME, duration, 0);
+}
+
+/* Bytes the frames of a sync point take. */
+static guint64 gst_lpc10_parse_frame_bytes(GstLpc10Parse* parse, guint64 nframes) {
+    return nframes / GST_LPC10_PACKING_FRAMES(parse->packing) * GST_LPC10_PACKING_BYTES(parse->packing);
+}
+
+/* Records a sync point, keeping the list in order of frames; one already known is left alone. */
+static void gst_lpc10_parse_add_sync(GstLpc10Parse* parse, guint64 frame, guint64 offset, guint size) {
+    GstLpc10ParseSync sync = {frame, offset, size};
+    guint i = parse->syncs->len;
+
+    while (i > 0 && g_array_index(parse->syncs, GstLpc10ParseSync, i - 1).frame > frame)
+        --i;
+    if (i > 0 && g_array_index(parse->syncs, GstLpc10ParseSync, i - 1).frame == frame) {
+        if (size)
+            g_array_index(parse->syncs, GstLpc10ParseSync, i - 1).size = size;
+        return;
+    }
+    g_array_insert_val(parse->syncs, i, sync);
+    // Seeks go to the sync point at or before the target, which has the decoder state for it
+    gst_base_parse_add_index_entry(GST_BASE_PARSE(parse), offset, frame * GST_LPC10_FRAME_DURATION, TRUE, TRUE);
+}
+
+/* Reads the index at the end of the file, which the sink pad can only do when upstream lets it
+ * pull. Each entry's size follows from where the next one starts. */
+static void gst_lpc10_parse_read_index(GstLpc10Parse* parse) {
+    GstPad* sinkpad = GST_BASE_PARSE_SINK_PAD(parse);
+    struct lpc10_file_sync* syncs;
+    GstBuffer* buf = NULL;
+    GstMapInfo map;
+    gint count;
+
+    if (parse->index_offset == 0 || GST_PAD_MODE(sinkpad) != GST_PAD_MODE_PULL)
+        return;
+    if (gst_pad_pull_range(sinkpad, parse->index_offset, LPC10_FILE_INDEX_BYTES(0), &buf) != GST_FLOW_OK)
+        return;
+    gst_buffer_map(buf, &map, GST_MAP_READ);
+    count = lpc10_file_index_read(NULL, 0, map.data, (int)map.size);
+    gst_buffer_unmap(buf, &map);
+    gst_buffer_unref(buf);
+    buf = NULL;
+    if (count <= 0 ||
+        gst_pad_pull_range(sinkpad, parse->index_offset, LPC10_FILE_INDEX_BYTES(count), &buf) != GST_FLOW_OK)
+        return;
+
+    syncs = g_new(struct lpc10_file_sync, count);
+    gst_buffer_map(buf, &map, GST_MAP_READ);
+    if (lpc10_file_index_read(syncs, count, map.data, (int)map.size) == count) {
+        for (gint i = 0; i < count; ++i) {
+            guint64 end = i + 1 < count ? (guint64)syncs[i + 1].offset : parse->index_offset;
+            guint64 frames = i + 1 < count ? (guint64)(syncs[i + 1].frame - syncs[i].frame)
+                                           : (guint64)parse->nframes - (guint64)syncs[i].frame;
+            guint64 size = end - (guint64)syncs[i].offset - gst_lpc10_parse_frame_bytes(parse, frames);
+
+            gst_lpc10_parse_add_sync(parse, syncs[i].frame, syncs[i].offset,
+                                     parse->nframes >= 0 && size <= LPC10_FILE_SYNC_BYTES ? (guint)size : 0);
+        }
+        GST_DEBUG_OBJECT(parse, "index of %d sync points at offset %" G_GUINT64_FORMAT, count, parse->index_offset);
+    }
+    gst_buffer_unmap(buf, &map);
+    gst_buffer_unref(buf);
+    g_free(syncs);
+}
+
+/* The file header: the packing of the stream, its length and where its index is. */
+static GstFlowReturn gst_lpc10_parse_header(GstLpc10Parse* parse, GstBaseParseFrame* frame, const GstMapInfo* map,
+                                            gint* framesize) {
+    GstBaseParse* base_parse = GST_BASE_PARSE(parse);
+    struct lpc10_file_header h;
+    gint n = lpc10_file_header_read(&h, map->data, (int)MIN(map->size, G_MAXINT));
+
+    if (n == 0 && !GST_BASE_PARSE_DRAINING(base_parse))
+        return GST_FLOW_OK;  // min_frame_size is the header size, so only at the end of a short file
+    if (n <= 0 && !gst_pad_has_current_caps(GST_BASE_PARSE_SINK_PAD(parse))) {
+        gst_lpc10_parse_start_raw(parse);
+        return GST_FLOW_OK;
+    }
+    if (n <= 0 || frame->offset != 0 || h.rate != 8000) {
+        GST_ELEMENT_ERROR(parse, STREAM, WRONG_TYPE, (NULL), ("Not an LPC-10 file of 8000 Hz speech"));
+        return GST_FLOW_ERROR;
+    }
+    parse->packing = h.tight ? GST_LPC10_PACKING_TIGHT : GST_LPC10_PACKING_BYTE;
+    parse->nframes = h.nframes;
+    parse->index_offset = (guint64)h.index;
+    parse->have_header = TRUE;
+    GST_DEBUG_OBJECT(parse, "LPC-10 file, %s packing, %" G_GINT64_FORMAT " frames, index at %" G_GUINT64_FORMAT,
+                     h.tight ? "tight" : "byte", parse->nframes, parse->index_offset);
+
+    gst_lpc10_parse_set_src_caps(parse);
+    if (h.nframes >= 0)
+        gst_base_parse_set_duration(base_parse, GST_FORMAT_TIME, h.nframes * GST_LPC10_FRAME_DURATION, 0);
+    gst_lpc10_parse_read_index(parse);
+
+    *framesize = LPC10_FILE_HEADER_BYTES;
+    return GST_FLOW_OK;
+}
+
+/* A sync point, where one is due, or after a seek the first one found. Its decoder state is
+ * sent downstream after a seek, so that lpc10dec carries on as if it had decoded the frames
+ * before. */
+static GstFlowReturn gst_lpc10_parse_sync(GstLpc10Parse* parse, GstBaseParseFrame* frame, const GstMapInfo* map,
+                                          gint* framesize, gint* skipsize) {
+    GstBaseParse* base_parse = GST_BASE_PARSE(parse);
+    gint avail = (gint)MIN(map->size, G_MAXINT), pos, size = -1;
+    long long first;
+    int nframes;
+
+    if (avail < LPC10_FILE_SYNC_HEAD && !GST_BASE_PARSE_DRAINING(base_parse)) {
+        gst_base_parse_set_min_frame_size(base_parse, LPC10_FILE_SYNC_HEAD);
+        return GST_FLOW_OK;
+    }
+
+    // The index follows the last frames, and is skipped as it comes
+    if (parse->synced && lpc10_file_sync_bytes(map->data, avail) < 0 &&
+        lpc10_file_index_read(NULL, 0, map->data, avail) >= 0) {
+        parse->skip = LPC10_FILE_INDEX_BYTES((guint64)lpc10_file_index_read(NULL, 0, map->data, avail));
+        parse->synced = FALSE;
+        *skipsize = (gint)MIN(parse->skip, (guint64)avail);
+        parse->skip -= (guint64)*skipsize;
+        return GST_FLOW_OK;
+    }
+
+    for (pos = 0; pos < avail; ++pos) {
+        size = lpc10_file_sync_bytes(map->data + pos, avail - pos);
+        if (size == 0 || (size > 0 && pos + size > avail))
+            break;  // Needs more data
+        if (size > 0 && lpc10_file_sync_read(&first, &nframes, NULL, map->data + pos, size) == size)
+            break;
+        if (parse->synced) {
+            GST_ELEMENT_ERROR(parse, STREAM, DECODE, (NULL),
+                              ("Damaged LPC-10 file: no sync point at offset %" G_GUINT64_FORMAT, frame->offset));
+            return GST_FLOW_ERROR;
+        }
+        size = -1;
+    }
+    if (pos > 0) {
+        GST_DEBUG_OBJECT(parse, "skipping %d bytes to a sync point", pos);
+        *skipsize = pos;
+        return GST_FLOW_OK;
+    }
+    if (size <= 0 || size > avail) {
+        gst_base_parse_set_min_frame_size(base_parse, size > 0 ? (guint)size : LPC10_FILE_SYNC_HEAD);
+        return GST_FLOW_OK;
+    }
+
+    if (!parse->synced) {
+        GST_DEBUG_OBJECT(parse, "sync point at frame %lld, offset %" G_GUINT64_FORMAT, first, frame->offset);
+        gst_buffer_replace(&parse->state, NULL);
+        parse->state = gst_buffer_copy_region(frame->buffer, GST_BUFFER_COPY_MEMORY, LPC10_FILE_SYNC_HEAD,
+                                              size - LPC10_FILE_SYNC_HEAD);
+    }
+    gst_lpc10_parse_add_sync(parse, (guint64)first, frame->offset, (guint)size);
+    parse->frame = (guint64)first;
+    parse->left = (guint)nframes;
+    parse->synced = TRUE;
+    gst_base_parse_set_min_frame_size(base_parse, GST_LPC10_PACKING_BYTES(parse->packing));
+
+    *framesize = size;
+    return GST_FLOW_OK;
+}
+
+static GstFlowReturn gst_lpc10_parse_handle_frame(GstBaseParse* base_parse, GstBaseParseFrame* frame, gint* skipsize) {
+    GstLpc10Parse* parse = GST_LPC10_PARSE(base_parse);
+    guint block_frames = GST_LPC10_PACKING_FRAMES(parse->packing);
+    guint block_bytes = GST_LPC10_PACKING_BYTES(parse->packing);
+    GstFlowReturn ret;
+    gint framesize = 0;
+    GstMapInfo map;
+    guint nblocks;
+
+    // Input from anywhere but where the last ended comes from a seek
+    if (frame->offset != parse->next_offset) {
+        GST_DEBUG_OBJECT(parse, "input at offset %" G_GUINT64_FORMAT " instead of %" G_GUINT64_FORMAT ", resyncing",
+                         frame->offset, parse->next_offset);
+        parse->synced = FALSE;
+        parse->skip = 0;
+    }
+
+    if (!gst_buffer_map(frame->buffer, &map, GST_MAP_READ)) {
+        GST_ERROR_OBJECT(parse, "Failed to map input buffer");
+        return GST_FLOW_ERROR;
+    }
+
+    *skipsize = 0;
+    if (parse->raw) {
+        ret = GST_FLOW_OK;
+        if (!parse->have_header)
+            gst_lpc10_parse_start_raw(parse);
+        nblocks = MIN(map.size / block_bytes, GST_LPC10_PARSE_MAX_FRAMES / block_frames);
+        gst_buffer_unmap(frame->buffer, &map);
+        parse->next_offset = frame->offset;
+        if (frame->offset % block_bytes) {
+            // Back in step with the blocks after a seek to a byte offset within one
+            *skipsize = (gint)(block_bytes - frame->offset % block_bytes);
+        } else if (nblocks == 0) {
+            if (GST_BASE_PARSE_DRAINING(base_parse))
+                *skipsize = (gint)map.size;
+        } else {
+            GST_BUFFER_PTS(frame->buffer) = frame->offset / block_bytes * block_frames * GST_LPC10_FRAME_DURATION;
+            GST_BUFFER_DURATION(frame->buffer) = nblocks * block_frames * GST_LPC10_FRAME_DURATION;
+            return gst_base_parse_finish_frame(base_parse, frame, (gint)(nblocks * block_bytes));
+        }
+        return ret;
+    } else if (parse->skip > 0) {
+        *skipsize = (gint)MIN(parse->skip, map.size);
+        parse->skip -= (guint64)*skipsize;
+        ret = GST_FLOW_OK;
+    } else if (!parse->have_header) {
+        ret = gst_lpc10_parse_header(parse, frame, &map, &framesize);
+    } else if (!parse->synced || parse->left == 0) {
+        ret = gst_lpc10_parse_sync(parse, frame, &map, &framesize, skipsize);
+    } else {
+        // As many whole blocks as there are, up to the next sync point
+        nblocks = MIN(map.size / block_bytes, MIN(parse->left, GST_LPC10_PARSE_MAX_FRAMES) / block_frames);
+        if (nblocks == 0) {
+            // A block cut short at the end of the file is dropped
+            if (GST_BASE_PARSE_DRAINING(base_parse))
+                *skipsize = (gint)map.size;
+            ret = GST_FLOW_OK;
+        } else {
+            GST_BUFFER_PTS(frame->buffer) = parse->frame * GST_LPC10_FRAME_DURATION;
+            GST_BUFFER_DURATION(frame->buffer) = nblocks * block_frames * GST_LPC10_FRAME_DURATION;
+            // Not a place to start decoding at: base parse only indexes the sync points
+            GST_BUFFER_FLAG_SET(frame->buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+            parse->frame += nblocks * block_frames;
+            parse->left -= nblocks * block_frames;
+            gst_buffer_unmap(frame->buffer, &map);
+            parse->next_offset = frame->offset + nblocks * block_bytes;
+            return gst_base_parse_finish_frame(base_parse, frame, (gint)(nblocks * block_bytes));
+        }
+    }
+    gst_buffer_unmap(frame->buffer, &map);
+
+    if (*skipsize > 0)
+        parse->next_offset = frame->offset + (guint64)*skipsize;
+    if (ret != GST_FLOW_OK || framesize == 0)
+        return ret;
+    // The header and sync points are not passed on
+    parse->next_offset = frame->offset + (guint64)framesize;
+    frame->flags |= GST_BASE_PARSE_FRAME_FLAG_DROP;
+    return gst_base_parse_finish_frame(base_parse, frame, framesize);
+}
+
+/* Sends the decoder state of the sync point a seek went to, right before its frames. Base parse
+ * is only left to clip frames after the segment: those before it are decoded from the sync
+ * point on, and lpc10dec clips their samples. */
+static GstFlowReturn gst_lpc10_parse_pre_push_frame(GstBaseParse* base_parse, GstBaseParseFrame* frame) {
+    GstLpc10Parse* parse = GST_LPC10_PARSE(base_parse);
+    GstBuffer* buf = frame->out_buffer ? frame->out_buffer : frame->buffer;
+
+    if (parse->state && !(frame->flags & GST_BASE_PARSE_FRAME_FLAG_DROP)) {
+        gst_pad_push_event(GST_BASE_PARSE_SRC_PAD(parse), gst_lpc10_decoder_state_event_new(parse->state));
+        gst_buffer_replace(&parse->state, NULL);
+    }
+    if (GST_BUFFER_PTS(buf) + GST_BUFFER_DURATION(buf) >= base_parse->segment.start)
+        frame->flags |= GST_BASE_PARSE_FRAME_FLAG_CLIP;
+    return GST_FLOW_OK;
+}
+
+/* Converts between TIME and BYTES exactly: by arithmetic in a bare stream, and in a file from the
+ * sync point before the position. */
+static gboolean gst_lpc10_parse_convert(GstBaseParse* base_parse, GstFormat src_format, gint64 src_value,
+                                        GstFormat dest_format, gint64* dest_value) {
+    GstLpc10Parse* parse = GST_LPC10_PARSE(base_parse);
+    guint block_frames = GST_LPC10_PACKING_FRAMES(parse->packing);
+    guint block_bytes = GST_LPC10_PACKING_BYTES(parse->packing);
+    const GstLpc10ParseSync* sync = NULL;
+    guint64 frame;
+
+    // A bare stream is all blocks
+    if (parse->raw && src_value >= 0 && src_format != dest_format) {
+        if (src_format == GST_FORMAT_TIME && dest_format == GST_FORMAT_BYTES) {
+            *dest_value = (gint64)((guint64)src_value / GST_LPC10_FRAME_DURATION / block_frames * block_bytes);
+            return TRUE;
+        }
+        if (src_format == GST_FORMAT_BYTES && dest_format == GST_FORMAT_TIME) {
+            *dest_value = (gint64)((guint64)src_value / block_bytes * block_frames * GST_LPC10_FRAME_DURATION);
+            return TRUE;
+        }
+    }
+
+    if (src_format == dest_format || src_value < 0 || parse->syncs->len == 0 ||
+        !((src_format == GST_FORMAT_TIME && dest_format == GST_FORMAT_BYTES) ||
+          (src_format == GST_FORMAT_BYTES && dest_format == GST_FORMAT_TIME)))
+        return gst_base_parse_convert_default(base_parse, src_format, src_value, dest_format, dest_value);
+
+    frame = src_format == GST_FORMAT_TIME ? (guint64)src_value / GST_LPC10_FRAME_DURATION : 0;
+    for (guint i = 0; i < parse->syncs->len; ++i) {
+        const GstLpc10ParseSync* s = &g_array_index(parse->syncs, GstLpc10ParseSync, i);
+
+        if (src_format == GST_FORMAT_TIME ? s->frame > frame : s->offset > (guint64)src_value)
+            break;
+        if (s->size > 0)
+            sync = s;
+    }
+    if (!sync)
+        return gst_base_parse_convert_default(base_parse, src_format, src_value, dest_format, dest_value);
+
+    if (src_format == GST_FORMAT_TIME) {
+        *dest_value = (gint64)(sync->offset + sync->size + (frame - sync->frame) / block_frames * block_bytes);
+    } else {
+        guint64 start = sync->offset + sync->size;
+        guint64 bytes = (guint64)src_value > start ? (guint64)src_value - start : 0;
+        *dest_value = (gint64)((sync->frame + bytes / block_bytes * block_frames) * GST_LPC10_FRAME_DURATION);
+    }
+    return TRUE;
+}
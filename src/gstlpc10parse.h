@@ -0,0 +1,53 @@
+#ifndef __GST_LPC10_PARSE_H__
+#define __GST_LPC10_PARSE_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstbaseparse.h>
+#include "lpc10.h"
+#include "gstlpc10_util.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_LPC10_PARSE (gst_lpc10_parse_get_type())
+#define GST_LPC10_PARSE(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_LPC10_PARSE, GstLpc10Parse))
+#define GST_LPC10_PARSE_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_LPC10_PARSE, GstLpc10ParseClass))
+#define GST_IS_LPC10_PARSE(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_LPC10_PARSE))
+#define GST_IS_LPC10_PARSE_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_LPC10_PARSE))
+
+typedef struct _GstLpc10Parse GstLpc10Parse;
+typedef struct _GstLpc10ParseClass GstLpc10ParseClass;
+
+/* A sync point of an LPC-10 file, known from its index or found while parsing. */
+typedef struct {
+    guint64 frame;   // Number of the frame after it
+    guint64 offset;  // Offset in the file
+    guint size;      // Bytes, up to the first frame after it
+} GstLpc10ParseSync;
+
+struct _GstLpc10Parse {
+    GstBaseParse parent;
+
+    GstLpc10Packing packing;
+    gboolean raw;          // A bare application/x-lpc10 stream, without header or sync points
+    gboolean have_header;  // The file header has been read, or the bare stream set up
+    gint64 nframes;        // Frames in the file from its header, -1 if not known
+    guint64 index_offset;  // Offset of the file's index, 0 if it has none
+    GArray* syncs;         // GstLpc10ParseSync, by frame
+
+    guint64 next_offset;  // Offset the next input should start at; anything else is a seek
+    gboolean synced;      // Within the frames of a sync point, at frame
+    guint64 frame;        // Number of the next frame
+    guint left;           // Frames before the next sync point
+    guint64 skip;         // Bytes of the index still to skip
+    GstBuffer* state;     // Decoder state to send downstream before the next frame, after a seek
+};
+
+struct _GstLpc10ParseClass {
+    GstBaseParseClass parent_class;
+};
+
+GType gst_lpc10_parse_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_LPC10_PARSE_H__ */
@@ -0,0 +1,150 @@
+#include "gstlpc10quant.h"
+#include "gstlpc10_util.h"
+#include "lpc10.h"
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+#include <string.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_lpc10_quant_debug_category);
+#define GST_CAT_DEFAULT gst_lpc10_quant_debug_category
+
+#include "gstlpc10_macros.h"
+
+/* Forward declarations for our static functions */
+GST_LPC10_BASE_TRANSFORM_PROTOTYPES(Quant, quant)
+static gboolean gst_lpc10_quant_transform_size(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                               gsize size, GstCaps* othercaps, gsize* othersize);
+
+/* GType registration */
+G_DEFINE_TYPE(GstLpc10Quant, gst_lpc10_quant, GST_TYPE_BASE_TRANSFORM)
+
+/* Class initialization function */
+static void gst_lpc10_quant_class_init(GstLpc10QuantClass* klass) {
+    GstElementClass* element_class = GST_ELEMENT_CLASS(klass);
+    GST_LPC10_BASE_TRANSFORM_ASSIGN(klass, quant)
+
+    GST_DEBUG_CATEGORY_INIT(gst_lpc10_quant_debug_category, "lpc10quant", 0, "LPC10 quantizer element");
+
+    base_transform_class->transform_size = GST_DEBUG_FUNCPTR(gst_lpc10_quant_transform_size);
+
+    gst_element_class_set_static_metadata(element_class, "LPC10 Quantizer", "Codec/Encoder/Audio",
+                                          "Quantizes LPC10 frame parameters into 7-byte LPC10 frames",
+                                          "Emin xeome@proton.me");
+
+    // Sink pad template: frame parameters, as lpc10enc puts them out
+    GstCaps* sink_caps = gst_lpc10_params_caps_new();
+    GstPadTemplate* sink_template = gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS, sink_caps);
+    gst_element_class_add_pad_template(element_class, sink_template);
+    gst_caps_unref(sink_caps);
+
+    // Source pad template: LPC10 bitstream output, 7-byte frames
+    GstCaps* src_caps = gst_lpc10_caps_new(GST_LPC10_PACKING_BYTE);
+    GstPadTemplate* src_template = gst_pad_template_new("src", GST_PAD_SRC, GST_PAD_ALWAYS, src_caps);
+    gst_element_class_add_pad_template(element_class, src_template);
+    gst_caps_unref(src_caps);
+}
+
+/* Instance initialization function */
+static void gst_lpc10_quant_init(GstLpc10Quant* quant) {
+    quant->lpc10_state = NULL;
+}
+
+static void gst_lpc10_quant_dispose(GObject* object) {
+    GstLpc10Quant* quant = GST_LPC10_QUANT(object);
+    GST_DEBUG_OBJECT(quant, "dispose");
+    if (quant->lpc10_state) {
+        g_free(quant->lpc10_state);
+        quant->lpc10_state = NULL;
+    }
+    G_OBJECT_CLASS(gst_lpc10_quant_parent_class)->dispose(object);
+}
+
+static void gst_lpc10_quant_finalize(GObject* object) {
+    GstLpc10Quant* quant = GST_LPC10_QUANT(object);
+    GST_DEBUG_OBJECT(quant, "finalize");
+    G_OBJECT_CLASS(gst_lpc10_quant_parent_class)->finalize(object);
+}
+
+static gboolean gst_lpc10_quant_start(GstBaseTransform* trans) {
+    GstLpc10Quant* quant = GST_LPC10_QUANT(trans);
+    GST_DEBUG_OBJECT(quant, "start");
+    g_free(quant->lpc10_state);
+    quant->lpc10_state = g_malloc0(sizeof(struct lpc10_encoder_state));
+    init_lpc10_encoder_state(quant->lpc10_state);
+    return TRUE;
+}
+
+static gboolean gst_lpc10_quant_stop(GstBaseTransform* trans) {
+    GstLpc10Quant* quant = GST_LPC10_QUANT(trans);
+    GST_DEBUG_OBJECT(quant, "stop");
+    if (quant->lpc10_state) {
+        g_free(quant->lpc10_state);
+        quant->lpc10_state = NULL;
+    }
+    return TRUE;
+}
+
+/* Parameters on the sink pad, 7-byte frames on the source pad, whatever the other side offers. */
+static GstCaps* gst_lpc10_quant_transform_caps(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                               GstCaps* filter) {
+    GstCaps* othercaps = direction == GST_PAD_SINK ? gst_lpc10_caps_new(GST_LPC10_PACKING_BYTE)
+                                                   : gst_lpc10_params_caps_new();
+
+    if (filter) {
+        GstCaps* intersection = gst_caps_intersect_full(filter, othercaps, GST_CAPS_INTERSECT_FIRST);
+
+        gst_caps_unref(othercaps);
+        othercaps = intersection;
+    }
+    return othercaps;
+}
+
+static gboolean gst_lpc10_quant_set_caps(GstBaseTransform* trans, GstCaps* incaps, GstCaps* outcaps) {
+    GST_DEBUG_OBJECT(trans, "quantizing %" GST_PTR_FORMAT " to %" GST_PTR_FORMAT, (void*)incaps, (void*)outcaps);
+    return TRUE;
+}
+
+/* One GstLpc10Params record for every 7-byte frame. */
+static gboolean gst_lpc10_quant_transform_size(GstBaseTransform* trans, GstPadDirection direction, GstCaps* caps,
+                                               gsize size, GstCaps* othercaps, gsize* othersize) {
+    if (direction == GST_PAD_SINK)
+        *othersize = size / GST_LPC10_PARAMS_BYTES * GST_LPC10_FRAME_BYTES;
+    else
+        *othersize = size / GST_LPC10_FRAME_BYTES * GST_LPC10_PARAMS_BYTES;
+    return TRUE;
+}
+
+static GstFlowReturn gst_lpc10_quant_transform(GstBaseTransform* trans, GstBuffer* inbuf, GstBuffer* outbuf) {
+    GstLpc10Quant* quant = GST_LPC10_QUANT(trans);
+    INT32 lpc10_bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+    GstLpc10Params params;
+    GstMapInfo in_map, out_map;
+    guint i, nframes;
+
+    if (!gst_buffer_map(inbuf, &in_map, GST_MAP_READ)) {
+        GST_ERROR_OBJECT(quant, "Failed to map input buffer");
+        return GST_FLOW_ERROR;
+    }
+    if (!gst_buffer_map(outbuf, &out_map, GST_MAP_WRITE)) {
+        GST_ERROR_OBJECT(quant, "Failed to map output buffer");
+        gst_buffer_unmap(inbuf, &in_map);
+        return GST_FLOW_ERROR;
+    }
+
+    nframes = in_map.size / GST_LPC10_PARAMS_BYTES;
+    if (in_map.size % GST_LPC10_PARAMS_BYTES)
+        GST_WARNING_OBJECT(quant, "Dropping %" G_GSIZE_FORMAT " bytes short of a frame",
+                           in_map.size % GST_LPC10_PARAMS_BYTES);
+
+    for (i = 0; i < nframes; ++i) {
+        // Copied out of the read-only input, which need not be aligned for the record either
+        memcpy(&params, in_map.data + i * GST_LPC10_PARAMS_BYTES, sizeof(params));
+        lpc10_quantize(params.voice, &params.pitch, &params.rms, params.rc, lpc10_bits, quant->lpc10_state);
+        gst_lpc10_pack_frames(lpc10_bits, out_map.data + i * GST_LPC10_FRAME_BYTES, 1, GST_LPC10_PACKING_BYTE);
+    }
+
+    gst_buffer_unmap(outbuf, &out_map);
+    gst_buffer_unmap(inbuf, &in_map);
+    gst_buffer_set_size(outbuf, nframes * GST_LPC10_FRAME_BYTES);
+    return GST_FLOW_OK;
+}
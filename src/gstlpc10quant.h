@@ -0,0 +1,35 @@
+#ifndef __GST_LPC10_QUANT_H__
+#define __GST_LPC10_QUANT_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+#include "lpc10.h"
+#include "gstlpc10_util.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_LPC10_QUANT (gst_lpc10_quant_get_type())
+#define GST_LPC10_QUANT(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_LPC10_QUANT, GstLpc10Quant))
+#define GST_LPC10_QUANT_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_LPC10_QUANT, GstLpc10QuantClass))
+#define GST_IS_LPC10_QUANT(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_LPC10_QUANT))
+#define GST_IS_LPC10_QUANT_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_LPC10_QUANT))
+
+typedef struct _GstLpc10Quant GstLpc10Quant;
+typedef struct _GstLpc10QuantClass GstLpc10QuantClass;
+
+/* The quantizer stage of lpc10enc on its own: application/x-lpc10-params in, 7-byte frames out. */
+struct _GstLpc10Quant {
+    GstBaseTransform parent;
+
+    struct lpc10_encoder_state* lpc10_state;  // Only the sync bit of it is used by lpc10_quantize()
+};
+
+struct _GstLpc10QuantClass {
+    GstBaseTransformClass parent_class;
+};
+
+GType gst_lpc10_quant_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_LPC10_QUANT_H__ */
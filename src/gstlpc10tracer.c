@@ -0,0 +1,186 @@
+#include "gstlpc10tracer.h"
+
+#ifdef GST_LPC10_HAVE_TRACER
+
+#include "gstlpc10enc.h"
+#include "gstlpc10dec.h"
+
+GST_DEBUG_CATEGORY_STATIC(gst_lpc10_tracer_debug_category);
+#define GST_CAT_DEFAULT gst_lpc10_tracer_debug_category
+
+G_DEFINE_TYPE(GstLpc10Tracer, gst_lpc10_tracer, GST_TYPE_TRACER)
+
+// One record per input buffer and one per output buffer, in the GST_TRACER log format gst-stats and
+// the other tracer tools parse
+static GstTracerRecord* tr_frame;
+static GstTracerRecord* tr_latency;
+
+// Per-element bookkeeping between the hooks, attached to the element so that it goes away with it.
+// Only the element's streaming thread touches it.
+typedef struct {
+    GstClockTime chain_start;  // ts of the chain call in progress, GST_CLOCK_TIME_NONE outside of one
+    GstClockTime push_start;   // ts of the push in progress
+    GstClockTime downstream;   // Time the chain call in progress spent in pushes, i.e. downstream
+    guint64 in_size;           // Size of the input buffer of the chain call in progress
+    guint64 out_size;          // Bytes pushed by the chain call in progress
+    guint out_buffers;         // Buffers pushed by the chain call in progress
+} GstLpc10TracerElement;
+
+static GQuark element_quark;
+
+/* Returns the lpc10enc or lpc10dec the pad belongs to, if it is the pad of one in the given direction */
+static GstElement* gst_lpc10_tracer_get_element(GstPad* pad, GstPadDirection direction) {
+    GstObject* parent = GST_OBJECT_PARENT(pad);
+
+    if (!parent || GST_PAD_DIRECTION(pad) != direction)
+        return NULL;
+    if (!GST_IS_LPC10_ENC(parent) && !GST_IS_LPC10_DEC(parent))
+        return NULL;
+    return GST_ELEMENT(parent);
+}
+
+static GstLpc10TracerElement* gst_lpc10_tracer_get_data(GstElement* element) {
+    GstLpc10TracerElement* data = g_object_get_qdata(G_OBJECT(element), element_quark);
+
+    if (!data) {
+        data = g_new0(GstLpc10TracerElement, 1);
+        data->chain_start = GST_CLOCK_TIME_NONE;
+        data->push_start = GST_CLOCK_TIME_NONE;
+        g_object_set_qdata_full(G_OBJECT(element), element_quark, data, g_free);
+    }
+    return data;
+}
+
+static void gst_lpc10_tracer_chain_pre(GstTracer* self, GstClockTime ts, GstPad* pad, GstBuffer* buffer) {
+    GstElement* element = gst_lpc10_tracer_get_element(pad, GST_PAD_SINK);
+    GstLpc10TracerElement* data;
+
+    if (!element)
+        return;
+    data = gst_lpc10_tracer_get_data(element);
+    data->chain_start = ts;
+    data->downstream = 0;
+    data->in_size = gst_buffer_get_size(buffer);
+    data->out_size = 0;
+    data->out_buffers = 0;
+}
+
+static void gst_lpc10_tracer_chain_post(GstTracer* self, GstClockTime ts, GstPad* pad, GstFlowReturn res) {
+    GstElement* element = gst_lpc10_tracer_get_element(pad, GST_PAD_SINK);
+    GstLpc10TracerElement* data;
+
+    if (!element)
+        return;
+    data = gst_lpc10_tracer_get_data(element);
+    if (!GST_CLOCK_TIME_IS_VALID(data->chain_start))
+        return;
+
+    gst_tracer_record_log(tr_frame, (guint64)(guintptr)g_thread_self(), ts, GST_OBJECT_NAME(element),
+                          ts - data->chain_start - data->downstream, data->in_size, data->out_size, data->out_buffers);
+    data->chain_start = GST_CLOCK_TIME_NONE;
+}
+
+static void gst_lpc10_tracer_push_pre(GstTracer* self, GstClockTime ts, GstPad* pad, GstBuffer* buffer) {
+    GstElement* element = gst_lpc10_tracer_get_element(pad, GST_PAD_SRC);
+    GstLpc10TracerElement* data;
+    GstClockTime pts = GST_BUFFER_PTS(buffer);
+    GstClockTime running_time, now;
+    GstClock* clock;
+    GstEvent* event;
+
+    if (!element)
+        return;
+    data = gst_lpc10_tracer_get_data(element);
+    data->push_start = ts;
+    data->out_size += gst_buffer_get_size(buffer);
+    data->out_buffers++;
+
+    // The latency of the buffer is how long after its running time it leaves, on the pipeline clock. For the
+    // encoder that takes in the frames it waits for and the time the input spent upstream; with a live source,
+    // whose timestamps are capture times, it is the whole capture to output latency
+    if (!GST_CLOCK_TIME_IS_VALID(pts))
+        return;
+    clock = gst_element_get_clock(element);
+    if (!clock)
+        return;
+    now = gst_clock_get_time(clock) - gst_element_get_base_time(element);
+    gst_object_unref(clock);
+
+    running_time = pts;
+    event = gst_pad_get_sticky_event(pad, GST_EVENT_SEGMENT, 0);
+    if (event) {
+        const GstSegment* segment;
+
+        gst_event_parse_segment(event, &segment);
+        running_time = gst_segment_to_running_time(segment, GST_FORMAT_TIME, pts);
+        gst_event_unref(event);
+    }
+    if (!GST_CLOCK_TIME_IS_VALID(running_time))
+        return;
+
+    gst_tracer_record_log(tr_latency, (guint64)(guintptr)g_thread_self(), ts, GST_OBJECT_NAME(element), pts,
+                          GST_CLOCK_DIFF(running_time, now), (guint64)gst_buffer_get_size(buffer));
+}
+
+static void gst_lpc10_tracer_push_post(GstTracer* self, GstClockTime ts, GstPad* pad, GstFlowReturn res) {
+    GstElement* element = gst_lpc10_tracer_get_element(pad, GST_PAD_SRC);
+    GstLpc10TracerElement* data;
+
+    if (!element)
+        return;
+    data = gst_lpc10_tracer_get_data(element);
+    if (GST_CLOCK_TIME_IS_VALID(data->chain_start) && GST_CLOCK_TIME_IS_VALID(data->push_start))
+        data->downstream += ts - data->push_start;
+    data->push_start = GST_CLOCK_TIME_NONE;
+}
+
+/* Describes a field of a record: a value of the given type */
+static GstStructure* gst_lpc10_tracer_value(GType type, const gchar* description) {
+    return gst_structure_new("value", "type", G_TYPE_GTYPE, type, "description", G_TYPE_STRING, description, NULL);
+}
+
+/* Describes a field of a record: what the record is about */
+static GstStructure* gst_lpc10_tracer_scope(GType type, GstTracerValueScope scope) {
+    return gst_structure_new("scope", "type", G_TYPE_GTYPE, type, "related-to", GST_TYPE_TRACER_VALUE_SCOPE, scope, NULL);
+}
+
+static void gst_lpc10_tracer_class_init(GstLpc10TracerClass* klass) {
+    GST_DEBUG_CATEGORY_INIT(gst_lpc10_tracer_debug_category, "lpc10tracer", 0, "LPC10 tracer");
+
+    element_quark = g_quark_from_static_string("GstLpc10TracerElement");
+
+    tr_frame = gst_tracer_record_new(
+        "lpc10-frame.class", "thread-id", GST_TYPE_STRUCTURE, gst_lpc10_tracer_scope(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_THREAD),
+        "ts", GST_TYPE_STRUCTURE, gst_lpc10_tracer_value(G_TYPE_UINT64, "event ts"), "element", GST_TYPE_STRUCTURE,
+        gst_lpc10_tracer_scope(G_TYPE_STRING, GST_TRACER_VALUE_SCOPE_ELEMENT), "time", GST_TYPE_STRUCTURE,
+        gst_lpc10_tracer_value(G_TYPE_UINT64, "time spent in the element for the input buffer, without downstream, in ns"),
+        "in-size", GST_TYPE_STRUCTURE, gst_lpc10_tracer_value(G_TYPE_UINT64, "size of the input buffer in bytes"), "out-size",
+        GST_TYPE_STRUCTURE, gst_lpc10_tracer_value(G_TYPE_UINT64, "bytes pushed while handling the input buffer"),
+        "out-buffers", GST_TYPE_STRUCTURE, gst_lpc10_tracer_value(G_TYPE_UINT, "buffers pushed while handling the input buffer"),
+        NULL);
+
+    tr_latency = gst_tracer_record_new(
+        "lpc10-latency.class", "thread-id", GST_TYPE_STRUCTURE, gst_lpc10_tracer_scope(G_TYPE_UINT64, GST_TRACER_VALUE_SCOPE_THREAD),
+        "ts", GST_TYPE_STRUCTURE, gst_lpc10_tracer_value(G_TYPE_UINT64, "event ts"), "element", GST_TYPE_STRUCTURE,
+        gst_lpc10_tracer_scope(G_TYPE_STRING, GST_TRACER_VALUE_SCOPE_ELEMENT), "pts", GST_TYPE_STRUCTURE,
+        gst_lpc10_tracer_value(G_TYPE_UINT64, "timestamp of the output buffer"), "latency", GST_TYPE_STRUCTURE,
+        gst_lpc10_tracer_value(G_TYPE_INT64, "pipeline clock running time minus the running time of the buffer, in ns"),
+        "size", GST_TYPE_STRUCTURE, gst_lpc10_tracer_value(G_TYPE_UINT64, "size of the output buffer in bytes"), NULL);
+
+#if GST_CHECK_VERSION(1, 10, 0)
+    // Created once per process, not leaks
+    GST_OBJECT_FLAG_SET(tr_frame, GST_OBJECT_FLAG_MAY_BE_LEAKED);
+    GST_OBJECT_FLAG_SET(tr_latency, GST_OBJECT_FLAG_MAY_BE_LEAKED);
+#endif
+}
+
+static void gst_lpc10_tracer_init(GstLpc10Tracer* self) {
+    GstTracer* tracer = GST_TRACER(self);
+
+    gst_tracing_register_hook(tracer, "pad-chain-pre", G_CALLBACK(gst_lpc10_tracer_chain_pre));
+    gst_tracing_register_hook(tracer, "pad-chain-post", G_CALLBACK(gst_lpc10_tracer_chain_post));
+    gst_tracing_register_hook(tracer, "pad-push-pre", G_CALLBACK(gst_lpc10_tracer_push_pre));
+    gst_tracing_register_hook(tracer, "pad-push-post", G_CALLBACK(gst_lpc10_tracer_push_post));
+}
+
+#endif /* GST_LPC10_HAVE_TRACER */
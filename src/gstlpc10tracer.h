@@ -0,0 +1,40 @@
+#ifndef __GST_LPC10_TRACER_H__
+#define __GST_LPC10_TRACER_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+// The tracer API appeared in GStreamer 1.8 and is left out of builds configured with tracer hooks disabled
+#if GST_CHECK_VERSION(1, 8, 0) && !defined(GST_DISABLE_GST_TRACER_HOOKS)
+#define GST_LPC10_HAVE_TRACER 1
+
+#include <gst/gsttracer.h>
+
+#define GST_TYPE_LPC10_TRACER (gst_lpc10_tracer_get_type())
+#define GST_LPC10_TRACER(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_LPC10_TRACER, GstLpc10Tracer))
+#define GST_LPC10_TRACER_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_LPC10_TRACER, GstLpc10TracerClass))
+#define GST_IS_LPC10_TRACER(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_LPC10_TRACER))
+#define GST_IS_LPC10_TRACER_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_LPC10_TRACER))
+
+typedef struct _GstLpc10Tracer GstLpc10Tracer;
+typedef struct _GstLpc10TracerClass GstLpc10TracerClass;
+
+// GST_TRACERS=lpc10: logs, for every lpc10enc and lpc10dec in the process, the time each input buffer
+// spent in the element (handle_frame and the framing around it, without the time spent downstream)
+// and, for every output buffer, how far behind the pipeline clock its timestamp is
+struct _GstLpc10Tracer {
+    GstTracer parent;
+};
+
+struct _GstLpc10TracerClass {
+    GstTracerClass parent_class;
+};
+
+GType gst_lpc10_tracer_get_type(void);
+
+#endif
+
+G_END_DECLS
+
+#endif /* __GST_LPC10_TRACER_H__ */
@@ -0,0 +1,100 @@
+#include "gstlpc10typefind.h"
+#include "gstlpc10_util.h"
+#include "lpc10.h"
+#include <gst/gst.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_lpc10_typefind_debug_category);
+#define GST_CAT_DEFAULT gst_lpc10_typefind_debug_category
+
+// Frames looked at in a bare stream: enough that a match is no accident, and 1.4 s of speech
+#define GST_LPC10_TYPEFIND_FRAMES 64
+
+// Fewest frames a stream must have to be taken for LPC10 at all
+#define GST_LPC10_TYPEFIND_MIN_FRAMES 16
+
+/* An LPC-10 file starts with its header, which says all there is to say. */
+static void gst_lpc10_typefind_file(GstTypeFind* tf, gpointer user_data) {
+    const guint8* data = gst_type_find_peek(tf, 0, LPC10_FILE_HEADER_BYTES);
+    struct lpc10_file_header h;
+
+    if (data && lpc10_file_header_read(&h, data, LPC10_FILE_HEADER_BYTES) == LPC10_FILE_HEADER_BYTES)
+        gst_type_find_suggest_empty_simple(tf, GST_TYPE_FIND_MAXIMUM, GST_LPC10_FILE_MEDIA_TYPE);
+}
+
+/* Bit 54 of every frame is the sync bit, which chanwr_ flips from one frame to the next (isync).
+ * Returns how many of the nframes - 1 frames after the first have it flipped, or -1 if the 7-byte
+ * frames have padding bits set, which lpc10enc never writes. */
+static gint gst_lpc10_typefind_sync_flips(const guint8* data, guint nframes, GstLpc10Packing packing) {
+    guint bit, prev = 2, flips = 0;
+
+    for (guint i = 0; i < nframes; ++i) {
+        if (packing == GST_LPC10_PACKING_TIGHT) {
+            bit = i * LPC10_BITS_IN_COMPRESSED_FRAME + LPC10_BITS_IN_COMPRESSED_FRAME - 1;
+            bit = (data[bit / 8] >> (bit % 8)) & 1;
+        } else {
+            const guint8 last = data[i * GST_LPC10_FRAME_BYTES + GST_LPC10_FRAME_BYTES - 1];
+
+            if (last & 0xc0)
+                return -1;
+            bit = (last >> 5) & 1;
+        }
+        flips += bit != prev && prev < 2;
+        prev = bit;
+    }
+    return (gint)flips;
+}
+
+/* A bare stream has no header, so it is told by its sync bits. In random data one flips or not
+ * with even odds; in a stream from lpc10enc every one flips, but for the frames DTX leaves out.
+ * The packing whose frames flip is suggested, the more likely the more frames there are. */
+static void gst_lpc10_typefind_stream(GstTypeFind* tf, gpointer user_data) {
+    guint64 length = gst_type_find_get_length(tf);
+
+    for (guint p = 0; p < 2; ++p) {
+        GstLpc10Packing packing = p ? GST_LPC10_PACKING_TIGHT : GST_LPC10_PACKING_BYTE;
+        guint block_frames = GST_LPC10_PACKING_FRAMES(packing);
+        guint block_bytes = GST_LPC10_PACKING_BYTES(packing);
+        guint nblocks = GST_LPC10_TYPEFIND_FRAMES / block_frames;
+        const guint8* data = NULL;
+        gint flips;
+
+        // A short stream is looked at whole, one of unknown length as far as there is data
+        if (length > 0)
+            nblocks = (guint)MIN(nblocks, length / block_bytes);
+        while (nblocks * block_frames >= GST_LPC10_TYPEFIND_MIN_FRAMES &&
+               !(data = gst_type_find_peek(tf, 0, nblocks * block_bytes)))
+            nblocks /= 2;
+        if (nblocks * block_frames < GST_LPC10_TYPEFIND_MIN_FRAMES)
+            continue;
+
+        flips = gst_lpc10_typefind_sync_flips(data, nblocks * block_frames, packing);
+        GST_LOG("%s packing: %d of %u sync bits flip", p ? "tight" : "byte", flips, nblocks * block_frames - 1);
+        if (flips < 0 || (guint)flips * 16 < (nblocks * block_frames - 1) * 15)
+            continue;
+
+        GstCaps* caps = gst_lpc10_caps_new(packing);
+        gst_type_find_suggest(tf,
+                              nblocks * block_frames >= GST_LPC10_TYPEFIND_FRAMES ? GST_TYPE_FIND_LIKELY
+                                                                                  : GST_TYPE_FIND_POSSIBLE,
+                              caps);
+        gst_caps_unref(caps);
+        return;
+    }
+}
+
+gboolean gst_lpc10_typefind_register(GstPlugin* plugin) {
+    GstCaps* file_caps = gst_caps_new_empty_simple(GST_LPC10_FILE_MEDIA_TYPE);
+    GstCaps* stream_caps = gst_lpc10_caps_new_template();
+    gboolean ret;
+
+    GST_DEBUG_CATEGORY_INIT(gst_lpc10_typefind_debug_category, "lpc10typefind", 0, "LPC10 typefinders");
+
+    // The file header is certain; the sync bits are only a strong hint, so other typefinders go first
+    ret = gst_type_find_register(plugin, GST_LPC10_FILE_MEDIA_TYPE, GST_RANK_PRIMARY, gst_lpc10_typefind_file,
+                                 "lpc10", file_caps, NULL, NULL) &&
+          gst_type_find_register(plugin, "application/x-lpc10", GST_RANK_MARGINAL, gst_lpc10_typefind_stream,
+                                 "lpc10,lpc", stream_caps, NULL, NULL);
+    gst_caps_unref(file_caps);
+    gst_caps_unref(stream_caps);
+    return ret;
+}
@@ -0,0 +1,15 @@
+#ifndef __GST_LPC10_TYPEFIND_H__
+#define __GST_LPC10_TYPEFIND_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/* Registers the typefinders for LPC-10 files (application/x-lpc10-file, from their header) and
+ * for bare LPC10 streams (application/x-lpc10 in either packing, from the sync bit that
+ * alternates from frame to frame), so that decodebin can autoplug lpc10parse and lpc10dec. */
+gboolean gst_lpc10_typefind_register(GstPlugin* plugin);
+
+G_END_DECLS
+
+#endif /* __GST_LPC10_TYPEFIND_H__ */
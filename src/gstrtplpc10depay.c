@@ -0,0 +1,99 @@
+#include "gstrtplpc10depay.h"
+#include "gstlpc10_util.h"  // For GST_LPC10_FRAME_BYTES and gst_lpc10_caps_new()
+#include <gst/gst.h>
+#include <gst/rtp/gstrtpbuffer.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_rtp_lpc10_depay_debug_category);
+#define GST_CAT_DEFAULT gst_rtp_lpc10_depay_debug_category
+
+/* Forward declarations for our static functions */
+static void gst_rtp_lpc10_depay_init(GstRtpLpc10Depay* depay);
+static void gst_rtp_lpc10_depay_class_init(GstRtpLpc10DepayClass* klass);
+static gboolean gst_rtp_lpc10_depay_set_caps(GstRTPBaseDepayload* depayload, GstCaps* caps);
+static GstBuffer* gst_rtp_lpc10_depay_process(GstRTPBaseDepayload* depayload, GstBuffer* buf);
+
+/* 7-byte frames, marked parsed: every buffer holds whole frames, so lpc10dec decodes a packet at a time. */
+static GstCaps* gst_rtp_lpc10_depay_src_caps_new(void) {
+    GstCaps* caps = gst_lpc10_caps_new(GST_LPC10_PACKING_BYTE);
+
+    gst_caps_set_simple(caps, "parsed", G_TYPE_BOOLEAN, TRUE, NULL);
+    return caps;
+}
+
+/* GType registration */
+G_DEFINE_TYPE(GstRtpLpc10Depay, gst_rtp_lpc10_depay, GST_TYPE_RTP_BASE_DEPAYLOAD)
+
+/* Class initialization function */
+static void gst_rtp_lpc10_depay_class_init(GstRtpLpc10DepayClass* klass) {
+    GstElementClass* element_class = GST_ELEMENT_CLASS(klass);
+    GstRTPBaseDepayloadClass* depayload_class = GST_RTP_BASE_DEPAYLOAD_CLASS(klass);
+
+    GST_DEBUG_CATEGORY_INIT(gst_rtp_lpc10_depay_debug_category, "rtplpc10depay", 0, "LPC10 RTP depayloader");
+
+    gst_element_class_set_static_metadata(element_class, "RTP LPC10 depayloader", "Codec/Depayloader/Network/RTP",
+                                          "Extracts LPC10 audio from RTP packets", "Emin xeome@proton.me");
+
+    // Sink pad template: RTP input, as produced by rtplpc10pay
+    GstCaps* sink_caps = gst_caps_from_string(
+        "application/x-rtp, media=(string)audio, payload=(int)[ 96, 127 ], clock-rate=(int)8000, encoding-name=(string)LPC10");
+    GstPadTemplate* sink_template = gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS, sink_caps);
+    gst_element_class_add_pad_template(element_class, sink_template);
+    gst_caps_unref(sink_caps);
+
+    // Source pad template: LPC10 bitstream output, whole frames in every buffer (parsed=true)
+    GstCaps* src_caps = gst_rtp_lpc10_depay_src_caps_new();
+    GstPadTemplate* src_template = gst_pad_template_new("src", GST_PAD_SRC, GST_PAD_ALWAYS, src_caps);
+    gst_element_class_add_pad_template(element_class, src_template);
+    gst_caps_unref(src_caps);
+
+    depayload_class->set_caps = GST_DEBUG_FUNCPTR(gst_rtp_lpc10_depay_set_caps);
+    depayload_class->process = GST_DEBUG_FUNCPTR(gst_rtp_lpc10_depay_process);
+}
+
+/* Instance initialization function */
+static void gst_rtp_lpc10_depay_init(GstRtpLpc10Depay* depay) {
+}
+
+static gboolean gst_rtp_lpc10_depay_set_caps(GstRTPBaseDepayload* depayload, GstCaps* caps) {
+    GstCaps* src_caps;
+    gboolean ret;
+
+    depayload->clock_rate = 8000;
+
+    src_caps = gst_rtp_lpc10_depay_src_caps_new();
+    ret = gst_pad_set_caps(GST_RTP_BASE_DEPAYLOAD_SRCPAD(depayload), src_caps);
+    gst_caps_unref(src_caps);
+    return ret;
+}
+
+/* Each packet carries one or more whole frames; the output buffer keeps them
+ * together, and lpc10dec decodes them all at once. */
+static GstBuffer* gst_rtp_lpc10_depay_process(GstRTPBaseDepayload* depayload, GstBuffer* buf) {
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+    GstBuffer* outbuf;
+    guint payload_len, nframes;
+
+    if (!gst_rtp_buffer_map(buf, GST_MAP_READ, &rtp)) {
+        GST_ELEMENT_WARNING(depayload, STREAM, DECODE, (NULL), ("Could not map RTP buffer"));
+        return NULL;
+    }
+
+    payload_len = gst_rtp_buffer_get_payload_len(&rtp);
+    nframes = payload_len / GST_LPC10_FRAME_BYTES;
+    if (nframes == 0) {
+        GST_WARNING_OBJECT(depayload, "dropping packet with %u byte payload, shorter than a frame", payload_len);
+        gst_rtp_buffer_unmap(&rtp);
+        return NULL;
+    }
+    if (payload_len % GST_LPC10_FRAME_BYTES != 0)
+        GST_WARNING_OBJECT(depayload, "ignoring %u trailing bytes of a partial frame", payload_len % GST_LPC10_FRAME_BYTES);
+
+    outbuf = gst_rtp_buffer_get_payload_subbuffer(&rtp, 0, nframes * GST_LPC10_FRAME_BYTES);
+    if (gst_rtp_buffer_get_marker(&rtp))
+        GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_RESYNC);
+    gst_rtp_buffer_unmap(&rtp);
+
+    GST_BUFFER_DURATION(outbuf) = nframes * GST_LPC10_FRAME_DURATION;
+    GST_LOG_OBJECT(depayload, "got %u frames", nframes);
+    return outbuf;
+}
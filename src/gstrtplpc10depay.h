@@ -0,0 +1,31 @@
+#ifndef __GST_RTP_LPC10_DEPAY_H__
+#define __GST_RTP_LPC10_DEPAY_H__
+
+#include <gst/gst.h>
+#include <gst/rtp/gstrtpbasedepayload.h>
+#include "lpc10.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_RTP_LPC10_DEPAY (gst_rtp_lpc10_depay_get_type())
+#define GST_RTP_LPC10_DEPAY(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_RTP_LPC10_DEPAY, GstRtpLpc10Depay))
+#define GST_RTP_LPC10_DEPAY_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_RTP_LPC10_DEPAY, GstRtpLpc10DepayClass))
+#define GST_IS_RTP_LPC10_DEPAY(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_RTP_LPC10_DEPAY))
+#define GST_IS_RTP_LPC10_DEPAY_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_RTP_LPC10_DEPAY))
+
+typedef struct _GstRtpLpc10Depay GstRtpLpc10Depay;
+typedef struct _GstRtpLpc10DepayClass GstRtpLpc10DepayClass;
+
+struct _GstRtpLpc10Depay {
+    GstRTPBaseDepayload parent;
+};
+
+struct _GstRtpLpc10DepayClass {
+    GstRTPBaseDepayloadClass parent_class;
+};
+
+GType gst_rtp_lpc10_depay_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_RTP_LPC10_DEPAY_H__ */
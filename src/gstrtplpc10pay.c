@@ -0,0 +1,257 @@
+#include "gstrtplpc10pay.h"
+#include "gstlpc10_util.h"  // For GST_LPC10_FRAME_BYTES, GST_LPC10_FRAME_DURATION
+#include <gst/gst.h>
+#include <gst/rtp/gstrtpbuffer.h>
+
+GST_DEBUG_CATEGORY_STATIC(gst_rtp_lpc10_pay_debug_category);
+#define GST_CAT_DEFAULT gst_rtp_lpc10_pay_debug_category
+
+/* RFC 3551 assigns the static payload type 7 to an older, incompatible LPC format,
+ * so LPC-10 frames are sent with a dynamic payload type and encoding name LPC10.
+ * Each packet carries a whole number of 7-byte frames, oldest first. */
+#define DEFAULT_FRAMES_PER_PACKET 4  // 90 ms per packet
+#define MAX_FRAMES_PER_PACKET 64
+
+enum { PROP_0, PROP_FRAMES_PER_PACKET };
+
+/* Forward declarations for our static functions */
+static void gst_rtp_lpc10_pay_init(GstRtpLpc10Pay* pay);
+static void gst_rtp_lpc10_pay_class_init(GstRtpLpc10PayClass* klass);
+static void gst_rtp_lpc10_pay_finalize(GObject* object);
+static void gst_rtp_lpc10_pay_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec);
+static void gst_rtp_lpc10_pay_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec);
+static gboolean gst_rtp_lpc10_pay_set_caps(GstRTPBasePayload* payload, GstCaps* caps);
+static GstFlowReturn gst_rtp_lpc10_pay_handle_buffer(GstRTPBasePayload* payload, GstBuffer* buffer);
+static gboolean gst_rtp_lpc10_pay_sink_event(GstRTPBasePayload* payload, GstEvent* event);
+static GstStateChangeReturn gst_rtp_lpc10_pay_change_state(GstElement* element, GstStateChange transition);
+
+/* GType registration */
+G_DEFINE_TYPE(GstRtpLpc10Pay, gst_rtp_lpc10_pay, GST_TYPE_RTP_BASE_PAYLOAD)
+
+/* Class initialization function */
+static void gst_rtp_lpc10_pay_class_init(GstRtpLpc10PayClass* klass) {
+    GObjectClass* gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass* element_class = GST_ELEMENT_CLASS(klass);
+    GstRTPBasePayloadClass* payload_class = GST_RTP_BASE_PAYLOAD_CLASS(klass);
+
+    GST_DEBUG_CATEGORY_INIT(gst_rtp_lpc10_pay_debug_category, "rtplpc10pay", 0, "LPC10 RTP payloader");
+
+    gobject_class->finalize = gst_rtp_lpc10_pay_finalize;
+    gobject_class->set_property = gst_rtp_lpc10_pay_set_property;
+    gobject_class->get_property = gst_rtp_lpc10_pay_get_property;
+
+    g_object_class_install_property(
+        gobject_class, PROP_FRAMES_PER_PACKET,
+        g_param_spec_uint("frames-per-packet", "Frames per packet",
+                          "Number of 22.5 ms LPC10 frames aggregated into one RTP packet. Downstream ptime/maxptime, the "
+                          "max-ptime property and the MTU can lower it further",
+                          1, MAX_FRAMES_PER_PACKET, DEFAULT_FRAMES_PER_PACKET, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+    gst_element_class_set_static_metadata(element_class, "RTP LPC10 payloader", "Codec/Payloader/Network/RTP",
+                                          "Payload-encodes LPC10 audio into RTP packets", "Emin xeome@proton.me");
+
+    // Sink pad template: LPC10 bitstream input
+    GstCaps* sink_caps = gst_caps_new_simple("application/x-lpc10", "framerate", GST_TYPE_FRACTION, 8000, LPC10_SAMPLES_PER_FRAME,
+                                             "frame-size", G_TYPE_INT, GST_LPC10_FRAME_BYTES, NULL);
+    GstPadTemplate* sink_template = gst_pad_template_new("sink", GST_PAD_SINK, GST_PAD_ALWAYS, sink_caps);
+    gst_element_class_add_pad_template(element_class, sink_template);
+    gst_caps_unref(sink_caps);
+
+    // Source pad template: RTP output
+    GstCaps* src_caps = gst_caps_from_string(
+        "application/x-rtp, media=(string)audio, payload=(int)[ 96, 127 ], clock-rate=(int)8000, encoding-name=(string)LPC10");
+    GstPadTemplate* src_template = gst_pad_template_new("src", GST_PAD_SRC, GST_PAD_ALWAYS, src_caps);
+    gst_element_class_add_pad_template(element_class, src_template);
+    gst_caps_unref(src_caps);
+
+    element_class->change_state = GST_DEBUG_FUNCPTR(gst_rtp_lpc10_pay_change_state);
+
+    payload_class->set_caps = GST_DEBUG_FUNCPTR(gst_rtp_lpc10_pay_set_caps);
+    payload_class->handle_buffer = GST_DEBUG_FUNCPTR(gst_rtp_lpc10_pay_handle_buffer);
+    payload_class->sink_event = GST_DEBUG_FUNCPTR(gst_rtp_lpc10_pay_sink_event);
+}
+
+/* Instance initialization function */
+static void gst_rtp_lpc10_pay_init(GstRtpLpc10Pay* pay) {
+    pay->adapter = gst_adapter_new();
+    pay->frames_per_packet = DEFAULT_FRAMES_PER_PACKET;
+    pay->peer_ptime = 0;
+    pay->peer_maxptime = 0;
+    pay->marker = TRUE;
+}
+
+static void gst_rtp_lpc10_pay_finalize(GObject* object) {
+    GstRtpLpc10Pay* pay = GST_RTP_LPC10_PAY(object);
+
+    g_object_unref(pay->adapter);
+    G_OBJECT_CLASS(gst_rtp_lpc10_pay_parent_class)->finalize(object);
+}
+
+static void gst_rtp_lpc10_pay_set_property(GObject* object, guint prop_id, const GValue* value, GParamSpec* pspec) {
+    GstRtpLpc10Pay* pay = GST_RTP_LPC10_PAY(object);
+
+    switch (prop_id) {
+        case PROP_FRAMES_PER_PACKET:
+            GST_OBJECT_LOCK(pay);
+            pay->frames_per_packet = g_value_get_uint(value);
+            GST_OBJECT_UNLOCK(pay);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+            break;
+    }
+}
+
+static void gst_rtp_lpc10_pay_get_property(GObject* object, guint prop_id, GValue* value, GParamSpec* pspec) {
+    GstRtpLpc10Pay* pay = GST_RTP_LPC10_PAY(object);
+
+    switch (prop_id) {
+        case PROP_FRAMES_PER_PACKET:
+            GST_OBJECT_LOCK(pay);
+            g_value_set_uint(value, pay->frames_per_packet);
+            GST_OBJECT_UNLOCK(pay);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+            break;
+    }
+}
+
+static gboolean gst_rtp_lpc10_pay_set_caps(GstRTPBasePayload* payload, GstCaps* caps) {
+    GstRtpLpc10Pay* pay = GST_RTP_LPC10_PAY(payload);
+    GstCaps* peer_caps;
+
+    // Pick up the packet duration the receiver asked for (SDP a=ptime / a=maxptime)
+    pay->peer_ptime = 0;
+    pay->peer_maxptime = 0;
+    peer_caps = gst_pad_peer_query_caps(GST_RTP_BASE_PAYLOAD_SRCPAD(payload), NULL);
+    if (peer_caps) {
+        if (!gst_caps_is_empty(peer_caps)) {
+            GstStructure* s = gst_caps_get_structure(peer_caps, 0);
+            gst_structure_get_uint(s, "ptime", &pay->peer_ptime);
+            gst_structure_get_uint(s, "maxptime", &pay->peer_maxptime);
+        }
+        gst_caps_unref(peer_caps);
+    }
+    GST_DEBUG_OBJECT(pay, "peer ptime %u ms, maxptime %u ms", pay->peer_ptime, pay->peer_maxptime);
+
+    gst_rtp_base_payload_set_options(payload, "audio", TRUE, "LPC10", 8000);
+    return gst_rtp_base_payload_set_outcaps(payload, NULL);
+}
+
+/* Number of frames to put in each packet: the frames-per-packet property, or the
+ * downstream ptime if given, capped by maxptime, max-ptime and the MTU. */
+static guint gst_rtp_lpc10_pay_get_packet_frames(GstRtpLpc10Pay* pay) {
+    GstRTPBasePayload* payload = GST_RTP_BASE_PAYLOAD(pay);
+    gint64 max_ptime = -1;
+    guint frames, mtu_frames;
+
+    GST_OBJECT_LOCK(pay);
+    frames = pay->frames_per_packet;
+    GST_OBJECT_UNLOCK(pay);
+    g_object_get(pay, "max-ptime", &max_ptime, NULL);
+
+    if (pay->peer_ptime > 0)
+        frames = pay->peer_ptime * GST_MSECOND / GST_LPC10_FRAME_DURATION;
+    if (pay->peer_maxptime > 0)
+        frames = MIN(frames, pay->peer_maxptime * GST_MSECOND / GST_LPC10_FRAME_DURATION);
+    if (max_ptime > 0)
+        frames = MIN(frames, (guint64)max_ptime / GST_LPC10_FRAME_DURATION);
+
+    mtu_frames = gst_rtp_buffer_calc_payload_len(GST_RTP_BASE_PAYLOAD_MTU(payload), 0, 0) / GST_LPC10_FRAME_BYTES;
+    frames = MIN(frames, mtu_frames);
+
+    return MAX(frames, 1);
+}
+
+/* Sends the first nframes frames in the adapter as one packet. */
+static GstFlowReturn gst_rtp_lpc10_pay_push_packet(GstRtpLpc10Pay* pay, guint nframes) {
+    GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+    guint payload_len = nframes * GST_LPC10_FRAME_BYTES;
+    GstClockTime pts;
+    guint64 distance;
+    GstBuffer* outbuf;
+
+    pts = gst_adapter_prev_pts(pay->adapter, &distance);
+    if (GST_CLOCK_TIME_IS_VALID(pts))
+        pts += (distance / GST_LPC10_FRAME_BYTES) * GST_LPC10_FRAME_DURATION;
+
+    outbuf = gst_rtp_buffer_new_allocate(payload_len, 0, 0);
+    gst_rtp_buffer_map(outbuf, GST_MAP_WRITE, &rtp);
+    gst_adapter_copy(pay->adapter, gst_rtp_buffer_get_payload(&rtp), 0, payload_len);
+    if (pay->marker) {
+        gst_rtp_buffer_set_marker(&rtp, TRUE);
+        pay->marker = FALSE;
+    }
+    gst_rtp_buffer_unmap(&rtp);
+    gst_adapter_flush(pay->adapter, payload_len);
+
+    GST_BUFFER_PTS(outbuf) = pts;
+    GST_BUFFER_DURATION(outbuf) = nframes * GST_LPC10_FRAME_DURATION;
+
+    GST_LOG_OBJECT(pay, "pushing %u frames at %" GST_TIME_FORMAT, nframes, GST_TIME_ARGS(pts));
+    return gst_rtp_base_payload_push(GST_RTP_BASE_PAYLOAD(pay), outbuf);
+}
+
+/* Sends whatever complete frames are still queued, e.g. before a gap or at EOS. */
+static GstFlowReturn gst_rtp_lpc10_pay_flush(GstRtpLpc10Pay* pay) {
+    guint nframes = gst_adapter_available(pay->adapter) / GST_LPC10_FRAME_BYTES;
+
+    if (nframes == 0)
+        return GST_FLOW_OK;
+    return gst_rtp_lpc10_pay_push_packet(pay, nframes);
+}
+
+static GstFlowReturn gst_rtp_lpc10_pay_handle_buffer(GstRTPBasePayload* payload, GstBuffer* buffer) {
+    GstRtpLpc10Pay* pay = GST_RTP_LPC10_PAY(payload);
+    GstFlowReturn ret = GST_FLOW_OK;
+    guint nframes = gst_rtp_lpc10_pay_get_packet_frames(pay);
+
+    if (GST_BUFFER_IS_DISCONT(buffer)) {
+        ret = gst_rtp_lpc10_pay_flush(pay);
+        gst_adapter_clear(pay->adapter);
+        pay->marker = TRUE;
+    }
+    gst_adapter_push(pay->adapter, buffer);
+
+    while (ret == GST_FLOW_OK && gst_adapter_available(pay->adapter) >= nframes * GST_LPC10_FRAME_BYTES)
+        ret = gst_rtp_lpc10_pay_push_packet(pay, nframes);
+
+    return ret;
+}
+
+static gboolean gst_rtp_lpc10_pay_sink_event(GstRTPBasePayload* payload, GstEvent* event) {
+    GstRtpLpc10Pay* pay = GST_RTP_LPC10_PAY(payload);
+
+    switch (GST_EVENT_TYPE(event)) {
+        case GST_EVENT_GAP:
+            // A pause in the stream (e.g. lpc10enc dtx=true): send what we have, and
+            // mark the first packet after it as the start of a talk spurt
+            gst_rtp_lpc10_pay_flush(pay);
+            pay->marker = TRUE;
+            break;
+        case GST_EVENT_EOS:
+            gst_rtp_lpc10_pay_flush(pay);
+            break;
+        case GST_EVENT_FLUSH_STOP:
+            gst_adapter_clear(pay->adapter);
+            pay->marker = TRUE;
+            break;
+        default:
+            break;
+    }
+    return GST_RTP_BASE_PAYLOAD_CLASS(gst_rtp_lpc10_pay_parent_class)->sink_event(payload, event);
+}
+
+static GstStateChangeReturn gst_rtp_lpc10_pay_change_state(GstElement* element, GstStateChange transition) {
+    GstRtpLpc10Pay* pay = GST_RTP_LPC10_PAY(element);
+    GstStateChangeReturn ret;
+
+    ret = GST_ELEMENT_CLASS(gst_rtp_lpc10_pay_parent_class)->change_state(element, transition);
+
+    if (transition == GST_STATE_CHANGE_PAUSED_TO_READY) {
+        gst_adapter_clear(pay->adapter);
+        pay->marker = TRUE;
+    }
+    return ret;
+}
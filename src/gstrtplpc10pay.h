@@ -0,0 +1,38 @@
+#ifndef __GST_RTP_LPC10_PAY_H__
+#define __GST_RTP_LPC10_PAY_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstadapter.h>
+#include <gst/rtp/gstrtpbasepayload.h>
+#include "lpc10.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_RTP_LPC10_PAY (gst_rtp_lpc10_pay_get_type())
+#define GST_RTP_LPC10_PAY(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_RTP_LPC10_PAY, GstRtpLpc10Pay))
+#define GST_RTP_LPC10_PAY_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_RTP_LPC10_PAY, GstRtpLpc10PayClass))
+#define GST_IS_RTP_LPC10_PAY(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), GST_TYPE_RTP_LPC10_PAY))
+#define GST_IS_RTP_LPC10_PAY_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass), GST_TYPE_RTP_LPC10_PAY))
+
+typedef struct _GstRtpLpc10Pay GstRtpLpc10Pay;
+typedef struct _GstRtpLpc10PayClass GstRtpLpc10PayClass;
+
+struct _GstRtpLpc10Pay {
+    GstRTPBasePayload parent;
+
+    GstAdapter* adapter;      // Frames waiting to be sent
+    guint frames_per_packet;  // "frames-per-packet" property
+    guint peer_ptime;         // "ptime" from downstream caps in ms, 0 if not given
+    guint peer_maxptime;      // "maxptime" from downstream caps in ms, 0 if not given
+    gboolean marker;          // Set the marker bit on the next packet (start of a talk spurt)
+};
+
+struct _GstRtpLpc10PayClass {
+    GstRTPBasePayloadClass parent_class;
+};
+
+GType gst_rtp_lpc10_pay_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_RTP_LPC10_PAY_H__ */
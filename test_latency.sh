@@ -0,0 +1,123 @@
+#!/bin/bash
+# Measures the delay of lpc10enc ! lpc10dec in a live pipeline and checks it against the
+# latency both elements report. Usage: ./test_latency.sh [low-delay] [packing]
+#
+# A live audiotestsrc plays quiet white noise that steps up to loud noise on a frame
+# boundary, once at each position of a frame within a packing=tight block. The delay of a
+# step is the running time at which its first loud sample leaves lpc10dec, less the
+# running time at which its first sample reached lpc10enc; the largest of them is what the
+# elements must report. The input comes in buffers of 20 samples (2.5 ms), so that lpc10enc
+# waits for the rest of the frame or block as it would on a capture device. Needs python3
+# with the GStreamer introspection bindings (gi).
+export GST_PLUGIN_PATH=$PWD/build:$GST_PLUGIN_PATH
+LOW_DELAY=${1:-"false"}
+PACKING=${2:-"byte"}
+
+exec python3 - "$LOW_DELAY" "$PACKING" <<'EOF'
+import sys
+from array import array
+
+import gi
+
+gi.require_version("Gst", "1.0")
+from gi.repository import GLib, Gst
+
+FRAME = 180  # Samples per frame
+FRAME_NS = 22500000
+CYCLE = 40  # Frames of quiet noise, then of loud noise, for each step
+STEPS = 4  # One step at each position within a 4-frame block
+BUFFER = 20  # Samples per input buffer
+SLACK_NS = 10000000  # Processing time allowed on top of the reported latency
+
+low_delay, packing = sys.argv[1], sys.argv[2]
+caps = "application/x-lpc10,packing=tight" if packing == "tight" else "application/x-lpc10"
+
+Gst.init(None)
+pipeline = Gst.parse_launch(
+    f"audiotestsrc is-live=true wave=white-noise volume=0.3 samplesperbuffer={BUFFER} "
+    f"num-buffers={(2 * CYCLE * STEPS + CYCLE) * FRAME // BUFFER} "
+    "! audio/x-raw,format=S16LE,rate=8000,channels=1 ! volume name=step volume=0.001 "
+    f"! lpc10enc name=enc low-delay={low_delay} ! {caps} ! lpc10dec name=dec ! fakesink sync=true")
+step, enc, dec = (pipeline.get_by_name(n) for n in ("step", "enc", "dec"))
+steps_in = []  # Running time at which each step reached lpc10enc
+steps_out = []  # Running time at which each step left lpc10dec
+samples_in = [0]  # Samples that reached lpc10enc
+
+
+def running_time():
+    return pipeline.get_clock().get_time() - pipeline.get_base_time()
+
+
+# Step k starts at frame (2k + 1) * CYCLE + k, and goes back to quiet noise CYCLE frames
+# later. The extra frame moves each step one frame further into a block.
+def step_start(k):
+    return ((2 * k + 1) * CYCLE + k) * FRAME
+
+
+def on_input(pad, info):
+    sample = samples_in[0]
+    samples_in[0] += info.get_buffer().get_size() // 2
+    k = len(steps_in)
+    if k < STEPS and sample == step_start(k):
+        step.set_property("volume", 1.0)
+        steps_in.append(running_time())
+    elif k > 0 and sample == step_start(k - 1) + CYCLE * FRAME:
+        step.set_property("volume", 0.001)
+    return Gst.PadProbeReturn.OK
+
+
+def on_output(pad, info):
+    buf = info.get_buffer()
+    ok, map_info = buf.map(Gst.MapFlags.READ)
+    if not ok:
+        return Gst.PadProbeReturn.OK
+    samples = array("h", bytes(map_info.data))
+    buf.unmap(map_info)
+    if len(steps_out) < len(steps_in):
+        for j, s in enumerate(samples):
+            if abs(s) > 328:  # 0.01 of full scale, as lpc10bench -l
+                if j % FRAME >= 8:  # Noise can start below the threshold; lpc10bench -l allows 8 samples too
+                    print(f"step {len(steps_out)}: first loud sample {j} is not at a frame boundary")
+                steps_out.append(running_time())
+                break
+    return Gst.PadProbeReturn.OK
+
+
+step.get_static_pad("sink").add_probe(Gst.PadProbeType.BUFFER, on_input)
+dec.get_static_pad("src").add_probe(Gst.PadProbeType.BUFFER, on_output)
+
+loop = GLib.MainLoop()
+bus = pipeline.get_bus()
+bus.add_signal_watch()
+bus.connect("message::eos", lambda *args: loop.quit())
+bus.connect("message::error", lambda bus, msg: (print(msg.parse_error()[0].message), loop.quit()))
+pipeline.set_state(Gst.State.PLAYING)
+GLib.timeout_add_seconds(30, loop.quit)
+loop.run()
+
+# The latency of lpc10enc and lpc10dec: that of the pipeline up to lpc10dec's source pad,
+# less that of the pipeline up to lpc10enc's sink pad
+reported = []
+for pad in (dec.get_static_pad("src"), enc.get_static_pad("sink")):
+    query = Gst.Query.new_latency()
+    ok = pad.query(query) if pad.get_direction() == Gst.PadDirection.SRC else pad.peer_query(query)
+    reported.append(query.parse_latency()[1] if ok else None)
+pipeline.set_state(Gst.State.NULL)
+
+print(f"### Live pipeline, low-delay={low_delay} packing={packing} ###")
+if None in reported or len(steps_out) < STEPS:
+    print(f"latency query answered: {None not in reported}, steps measured: {len(steps_out)} of {STEPS}")
+    sys.exit(1)
+delays = [out - t for t, out in zip(steps_in, steps_out)]
+for k, delay in enumerate(delays):
+    print(f"step {k}: {delay / 1e6:.1f} ms ({delay / FRAME_NS:.2f} frames)")
+latency = reported[0] - reported[1]
+measured = max(delays)
+print(f"reported {latency / 1e6:.1f} ms, measured {measured / 1e6:.1f} ms")
+# The first buffer of a step already holds BUFFER of its samples when it arrives, so the
+# worst case is that much below the latency, plus the time taken to process it
+expected = latency - BUFFER * Gst.SECOND // 8000
+if measured < expected - 1000000 or measured > expected + SLACK_NS:
+    print("measured delay does not match the reported latency")
+    sys.exit(1)
+EOF
@@ -0,0 +1,14 @@
+#!/bin/bash
+# Restores damaged encoder and decoder states with lpc10bench -f, built with AddressSanitizer and
+# UndefinedBehaviorSanitizer: every state lpc10_*_state_restore accepts is run on for a few frames, which must
+# neither fault nor give samples that are not finite. Usage: ./test_state_fuzz.sh [iterations] [frames]
+ITERATIONS=${1:-"100000"}
+FRAMES=${2:-"4000"}
+CC=${CC:-cc}
+BIN=$(mktemp -d)/lpc10bench-fuzz
+trap 'rm -rf "$(dirname "$BIN")"' EXIT
+
+cd "$(dirname "$0")" || exit 1
+$CC -std=c17 -O1 -g -fsanitize=address,undefined,float-cast-overflow -fno-sanitize-recover=all \
+    -Ilpc10 tools/lpc10bench.c lpc10/*.c -lm -lpthread -o "$BIN" || exit 1
+"$BIN" -n "$FRAMES" -f "$ITERATIONS"
@@ -10,7 +10,6 @@ capsfilter caps="audio/x-raw, format=S16LE, rate=8000, channels=1, layout=interl
 lpc10enc ! filesink location=output.lpc
 
 echo -e "\n\n### Step 2: Decoding output.lpc to audio sink ###"
-gst-launch-1.0 --gst-debug="lpc10enc:4,lpc10dec:4" -v \
-filesrc location=output.lpc ! \
-capsfilter caps="application/x-lpc10, framerate=8000/180, frame-size=7" ! \
+gst-launch-1.0 --gst-debug="lpc10parse:4,lpc10dec:4" -v \
+filesrc location=output.lpc ! lpc10parse ! \
 lpc10dec ! audioconvert ! audioresample ! autoaudiosink
@@ -0,0 +1,636 @@
+/*
+ * lpc10bench - throughput benchmark for the LPC10 codec core.
+ *
+ * Encodes and then decodes a corpus of S16LE 8 kHz mono speech, timing
+ * lpc10_encode() and lpc10_decode() separately.  The corpus is either a raw
+ * file given on the command line or a synthetic one made of vowel-like
+ * talk spurts separated by background-noise pauses, so that the decoder's
+ * silence path is exercised at a realistic ratio.
+ *
+ * With -d, it instead runs the encoder over that many hours of the corpus
+ * (looped, with a varying gain) and checks that the running sums the encoder
+ * keeps from frame to frame have not drifted from a double precision
+ * reference.
+ *
+ * With -l, it measures the delay of the encoder (in both modes) and of the
+ * decoder on a step from background noise to loud noise, and checks it
+ * against the LPC10_*_DELAY constants that lpc10enc and lpc10dec report as
+ * their latency.
+ *
+ * With -p, it encodes the corpus once in one piece and once split into that
+ * many chunks on as many threads with lpc10_encode_chunk(), then decodes the
+ * stream both ways, the chunks started from lpc10_decode_skip(), and reports
+ * the speedups and how many frames differ.
+ *
+ * Built with -DLPC10_PROFILE=ON, it also prints how the encoder's analysis
+ * and the decoder's synthesis time divides between their stages, as counted
+ * by the core in the last repeat.
+ *
+ * With -f, it damages saved encoder and decoder states that many times
+ * each, restores them, and runs the codec on from those that restore.
+ * Build it with -fsanitize=address,undefined (test_state_fuzz.sh does) to
+ * have that check that lpc10_*_state_restore let through no state the
+ * codec could fault on.
+ *
+ * Usage: lpc10bench [-n frames] [-s silence-percent] [-r repeats] [-d hours] [-l] [-p threads] [-f iterations] [file.raw]
+ */
+
+#define _DEFAULT_SOURCE  // M_PI, clock_gettime() and getopt() under -std=c17
+
+#include "lpc10.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_SPURT_FRAMES 40  // Length of one talk spurt + pause cycle
+#define BENCH_DRIFT_LIMIT 1e-5  // Largest running-sum drift -d accepts
+#define BENCH_STEP_FRAME 50     // Frame at which -l switches to loud noise
+#define BENCH_STEP_EDGE 8       // Samples (1 ms) at the start of a frame within which -l looks for the step
+#define BENCH_FUZZ_STATES 24    // States -f saves of each kind, through the corpus
+#define BENCH_FUZZ_FRAMES 8     // Frames -f runs a damaged state that restored for
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t lcg_next(uint32_t* seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed;
+}
+
+/*
+ * Fills `out` with `frames` frames of synthetic speech.  Each cycle of
+ * BENCH_SPURT_FRAMES frames starts with a talk spurt (a glottal pulse train
+ * with a slowly gliding pitch through two formant resonators) and ends with
+ * a pause of low-level noise whose length is `silence_pct` of the cycle.
+ */
+static void make_corpus(real* out, int frames, int silence_pct) {
+    const int spurt = BENCH_SPURT_FRAMES * (100 - silence_pct) / 100 * LPC10_SAMPLES_PER_FRAME;
+    const int cycle = BENCH_SPURT_FRAMES * LPC10_SAMPLES_PER_FRAME;
+    const double f1 = 700.0, f2 = 1200.0, r = 0.97;
+    const double a1 = 2 * r * cos(2 * M_PI * f1 / 8000), a2 = 2 * r * cos(2 * M_PI * f2 / 8000);
+    double y1[2] = {0, 0}, y2[2] = {0, 0};
+    double phase = 0;
+    uint32_t seed = 1;
+
+    for (int i = 0; i < frames * LPC10_SAMPLES_PER_FRAME; ++i) {
+        int pos = i % cycle;
+        double noise = ((int32_t)(lcg_next(&seed) >> 16) - 32768) / 32768.0;
+        double x;
+
+        if (pos < spurt) {
+            double pitch = 60 + 20 * sin(2 * M_PI * pos / (double)spurt);
+            phase += 1.0 / pitch;
+            x = 0.02 * noise;
+            if (phase >= 1.0) {
+                phase -= 1.0;
+                x += 1.0;
+            }
+        } else {
+            x = 0.0003 * noise;
+        }
+        double v1 = x + a1 * y1[0] - r * r * y1[1];
+        y1[1] = y1[0];
+        y1[0] = v1;
+        double v2 = v1 + a2 * y2[0] - r * r * y2[1];
+        y2[1] = y2[0];
+        y2[0] = v2;
+        double s = pos < spurt ? v2 * 0.04 : x;
+        out[i] = (real)(s > 1.0 ? 1.0 : s < -1.0 ? -1.0 : s);
+    }
+}
+
+static real* load_raw(const char* path, int* frames) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long bytes = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    *frames = (int)(bytes / (2 * LPC10_SAMPLES_PER_FRAME));
+
+    int16_t* pcm = malloc((size_t)*frames * LPC10_SAMPLES_PER_FRAME * sizeof(int16_t));
+    real* out = malloc((size_t)*frames * LPC10_SAMPLES_PER_FRAME * sizeof(real));
+    size_t got = fread(pcm, sizeof(int16_t), (size_t)*frames * LPC10_SAMPLES_PER_FRAME, f);
+    fclose(f);
+    for (size_t i = 0; i < got; ++i) {
+        out[i] = pcm[i] / 32768.0f;
+    }
+    free(pcm);
+    return out;
+}
+
+/*
+ * Encodes `hours` of audio made by looping `corpus` with a gain that changes
+ * every frame, and after every frame compares the onset detector's running
+ * sum (l2sum1) with a reference: a double precision running sum of the same
+ * FPC values over the whole run.  The FPC values are followed sample by sample
+ * from the preemphasized samples of the frame (pebuf), as onset_ computes
+ * them, and checked against the encoder's at the end of every frame.  Returns
+ * the largest difference seen, or -1 if the FPC values were not the same.
+ */
+static double drift_check(const real* corpus, int frames, double hours) {
+    const long total = (long)(hours * 3600 / 0.0225);
+    struct lpc10_encoder_state* enc = create_lpc10_encoder_state();
+    INT32 bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+    real speech[LPC10_SAMPLES_PER_FRAME];
+    real n = enc->n, d = enc->d__, fpc = enc->fpc;
+    double window[8] = {0}, sum = 0, worst = 0;
+    uint32_t seed = 1;
+    int next = 0;
+
+    for (long i = 0; i < total; ++i) {
+        const real* in = corpus + (size_t)(i % frames) * LPC10_SAMPLES_PER_FRAME;
+        real gain = 0.25f + (lcg_next(&seed) >> 8) / 16777216.0f;
+        for (int j = 0; j < LPC10_SAMPLES_PER_FRAME; ++j) {
+            speech[j] = in[j] * gain;
+        }
+        lpc10_encode(speech, bits, enc);
+
+        // The newest frame is the last of pebuf, which holds samples 181 to 720 of onset_'s buffer
+        const real* pe = enc->pebuf + 540 - LPC10_SAMPLES_PER_FRAME;
+        for (int j = 0; j < LPC10_SAMPLES_PER_FRAME; ++j) {
+            n = (pe[j] * pe[j - 1] + n * 63.f) / 64.f;
+            d = (pe[j - 1] * pe[j - 1] + d * 63.f) / 64.f;
+            if (d != 0.f)
+                fpc = fabsf(n) > d ? (n >= 0 ? 1.f : -1.f) : n / d;
+            sum += (double)fpc - window[next];
+            window[next] = fpc;
+            next = (next + 1) % 8;
+        }
+        if (n != enc->n || d != enc->d__ || fpc != enc->fpc) {
+            worst = -1;
+            break;
+        }
+        double diff = fabs((double)enc->l2sum1 - sum);
+        if (diff > worst)
+            worst = diff;
+    }
+    free(enc);
+    return worst;
+}
+
+/*
+ * Fills `out` with one frame of white noise at level `gain`.
+ */
+static void make_noise(real* out, real gain, uint32_t* seed) {
+    for (int i = 0; i < LPC10_SAMPLES_PER_FRAME; ++i) {
+        out[i] = gain * ((int32_t)(lcg_next(seed) >> 16) - 32768) / 32768.0f;
+    }
+}
+
+/*
+ * Returns the number of frames by which the output of `dec` lags behind the
+ * bits given to it: bits of background noise are followed, from frame
+ * BENCH_STEP_FRAME on, by bits of loud noise, and the first loud output
+ * sample is looked for.  If `enc` is given, the bits are encoded from a step
+ * in the input at the same frame instead, and the delay of both is returned.
+ * Unvoiced frames are used so that the step is not smeared by pitch epochs.
+ * The noise may well start below the threshold for a sample or two, so the
+ * step counts as frame aligned if a loud sample is among the first
+ * BENCH_STEP_EDGE of the frame; a delay that is not a whole number of frames
+ * is returned as -1.
+ */
+static int measure_delay(struct lpc10_encoder_state* enc, struct lpc10_decoder_state* dec) {
+    INT32 quiet[LPC10_BITS_IN_COMPRESSED_FRAME], loud[LPC10_BITS_IN_COMPRESSED_FRAME];
+    INT32 bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+    real speech[LPC10_SAMPLES_PER_FRAME];
+    uint32_t seed = 1;
+
+    if (!enc) {
+        struct lpc10_encoder_state* ref = create_lpc10_encoder_state();
+        for (int i = 0; i < 2 * BENCH_STEP_FRAME; ++i) {
+            make_noise(speech, i < BENCH_STEP_FRAME ? 0.0003f : 0.3f, &seed);
+            lpc10_encode(speech, i < BENCH_STEP_FRAME ? quiet : loud, ref);
+        }
+        free(ref);
+    }
+    for (int i = 0; i < 2 * BENCH_STEP_FRAME; ++i) {
+        if (enc) {
+            make_noise(speech, i < BENCH_STEP_FRAME ? 0.0003f : 0.3f, &seed);
+            lpc10_encode(speech, bits, enc);
+        } else {
+            memcpy(bits, i < BENCH_STEP_FRAME ? quiet : loud, sizeof(bits));
+        }
+        lpc10_decode(bits, speech, dec);
+        for (int j = 0; j < LPC10_SAMPLES_PER_FRAME; ++j) {
+            if (fabsf(speech[j]) > 0.01f)
+                return j < BENCH_STEP_EDGE ? i - BENCH_STEP_FRAME : -1;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Measures the encoder and decoder delays and prints them next to the
+ * constants.  Returns the number that differ.
+ */
+static int latency_check(void) {
+    const int expect[3] = {LPC10_ENCODER_DELAY, LPC10_ENCODER_LOW_DELAY, LPC10_DECODER_DELAY};
+    const char* name[3] = {"encoder", "encoder (low)", "decoder"};
+    int got[3], failed = 0;
+
+    for (int k = 0; k < 3; ++k) {
+        struct lpc10_encoder_state* enc = k < 2 ? create_lpc10_encoder_state() : NULL;
+        struct lpc10_decoder_state* dec = create_lpc10_decoder_state();
+        if (enc)
+            enc->lowdelay = k == 1;
+        got[k] = measure_delay(enc, dec);
+        free(enc);
+        free(dec);
+    }
+    // The encoder alone is what the encoder and the decoder add up to, less the decoder
+    got[0] = got[0] < 0 || got[2] < 0 ? -1 : got[0] - got[2];
+    got[1] = got[1] < 0 || got[2] < 0 ? -1 : got[1] - got[2];
+
+    for (int k = 0; k < 3; ++k) {
+        printf("%-14s %d frames (%.1f ms), expected %d\n", name[k], got[k], got[k] * 22.5, expect[k]);
+        failed += got[k] != expect[k];
+    }
+    return failed;
+}
+
+/*
+ * Returns 1 if any of the `n` samples is not finite, so that it would not
+ * convert to 16 bits.
+ */
+static int speech_bad(const real* speech, int n) {
+    for (int i = 0; i < n; ++i) {
+        if (!isfinite(speech[i]))
+            return 1;
+    }
+    return 0;
+}
+
+/* Damages `len` bytes of a saved state: flipped bits and changed bytes, or the end cut off. */
+static int damage_state(unsigned char* bytes, int len, uint32_t* seed) {
+    int changes = 1 + lcg_next(seed) % 4;
+
+    if (lcg_next(seed) % 8 == 0)
+        return (int)(lcg_next(seed) % (uint32_t)len);
+    for (int c = 0; c < changes; ++c) {
+        uint32_t r = lcg_next(seed);
+        int at = (int)((r >> 8) % (uint32_t)len);
+        if (r & 1)
+            bytes[at] ^= (unsigned char)(1u << ((r >> 1) & 7));
+        else
+            bytes[at] = (unsigned char)(lcg_next(seed) >> 24);
+    }
+    return len;
+}
+
+/*
+ * Saves encoder and decoder states at BENCH_FUZZ_STATES points, the first
+ * four frames and then evenly through the corpus, then restores `iterations`
+ * damaged copies of each kind.  A state that restores is run for
+ * BENCH_FUZZ_FRAMES frames: encoding the corpus, or decoding random bits,
+ * concealing a frame and skipping some.  That must not fault, which a build
+ * with -fsanitize=address,undefined checks, and must give finite samples.
+ * Returns the number of decoder states that did not.
+ */
+static int restore_fuzz(const real* corpus, int frames, int iterations) {
+    static unsigned char enc_saved[BENCH_FUZZ_STATES][LPC10_ENCODER_STATE_BYTES];
+    static unsigned char dec_saved[BENCH_FUZZ_STATES][LPC10_DECODER_STATE_BYTES];
+    int enc_len[BENCH_FUZZ_STATES], dec_len[BENCH_FUZZ_STATES];
+    unsigned char damaged[LPC10_ENCODER_STATE_BYTES], bytes[4 * LPC10_BYTES_IN_COMPRESSED_FRAME];
+    struct lpc10_encoder_state* enc = create_lpc10_encoder_state();
+    struct lpc10_decoder_state* dec = create_lpc10_decoder_state();
+    INT32 bits[LPC10_BITS_IN_COMPRESSED_FRAME];
+    real speech[LPC10_SAMPLES_PER_FRAME];
+    int restored[2] = {0, 0}, failed = 0, n = 0;
+    uint32_t seed = 1;
+
+    for (int i = 0; i < frames && n < BENCH_FUZZ_STATES; ++i) {
+        memcpy(speech, corpus + (size_t)i * LPC10_SAMPLES_PER_FRAME, sizeof(speech));
+        lpc10_encode(speech, bits, enc);
+        // Random bits up to every other state saved, so that some have the error corrector going
+        if (n & 1) {
+            for (int b = 0; b < LPC10_BITS_IN_COMPRESSED_FRAME; ++b)
+                bits[b] = lcg_next(&seed) >> 31;
+        }
+        lpc10_decode(bits, speech, dec);
+        if (i == (n < 4 ? n : (n - 3) * (frames - 1) / (BENCH_FUZZ_STATES - 4))) {
+            enc_len[n] = lpc10_encoder_state_save(enc, enc_saved[n]);
+            dec_len[n] = lpc10_decoder_state_save(dec, dec_saved[n]);
+            ++n;
+        }
+    }
+
+    for (int it = 0; it < 2 * iterations; ++it) {
+        int s = (int)(lcg_next(&seed) % (uint32_t)n), kind = it & 1, len, bad = 0;
+
+        init_lpc10_encoder_state(enc);
+        init_lpc10_decoder_state(dec);
+        if (kind == 0) {
+            memcpy(damaged, enc_saved[s], (size_t)enc_len[s]);
+            len = damage_state(damaged, enc_len[s], &seed);
+            if (lpc10_encoder_state_restore(enc, damaged, len) < 0)
+                continue;
+            for (int f = 0; f < BENCH_FUZZ_FRAMES; ++f) {
+                memcpy(speech, corpus + (size_t)((s + f) % frames) * LPC10_SAMPLES_PER_FRAME, sizeof(speech));
+                lpc10_encode(speech, bits, enc);
+            }
+        } else {
+            memcpy(damaged, dec_saved[s], (size_t)dec_len[s]);
+            len = damage_state(damaged, dec_len[s], &seed);
+            if (lpc10_decoder_state_restore(dec, damaged, len) < 0)
+                continue;
+            for (int f = 0; f < BENCH_FUZZ_FRAMES; ++f) {
+                for (int b = 0; b < LPC10_BITS_IN_COMPRESSED_FRAME; ++b)
+                    bits[b] = lcg_next(&seed) >> 31;
+                if (f == BENCH_FUZZ_FRAMES / 2)
+                    lpc10_conceal(speech, dec);
+                else
+                    lpc10_decode(bits, speech, dec);
+                bad |= speech_bad(speech, LPC10_SAMPLES_PER_FRAME);
+            }
+            for (size_t b = 0; b < sizeof(bytes); ++b)
+                bytes[b] = (unsigned char)(lcg_next(&seed) >> 24);
+            lpc10_decode_skip(bytes, 4, 0, dec);
+            lpc10_decode(bits, speech, dec);
+            bad |= speech_bad(speech, LPC10_SAMPLES_PER_FRAME);
+        }
+        restored[kind]++;
+        failed += bad;
+    }
+    printf("encoder:       %d of %d damaged states restored\n", restored[0], iterations);
+    printf("decoder:       %d of %d damaged states restored, %d gave samples that are not finite\n", restored[1],
+           iterations, failed);
+    free(enc);
+    free(dec);
+    return failed;
+}
+
+/* A chunk of the corpus for -p */
+typedef struct {
+    const INT16* pcm;
+    int nsamples;
+    int first, nframes;
+    unsigned char* bytes;  // Where the chunk's frames go in the whole stream
+} BenchChunk;
+
+static void* encode_chunk(void* arg) {
+    BenchChunk* c = arg;
+    struct lpc10_encoder_state* enc = create_lpc10_encoder_state();
+
+    lpc10_encode_chunk(c->pcm, c->nsamples, c->first, c->nframes, LPC10_CHUNK_WARMUP, c->bytes, 0, enc);
+    free(enc);
+    return NULL;
+}
+
+/* A chunk of the stream for -p, decoded from `dec` (the state at frame `start`) into `out` */
+typedef struct {
+    const unsigned char* bytes;
+    int start, first, nframes;
+    struct lpc10_decoder_state dec;
+    INT16* out;
+} BenchDecChunk;
+
+static void* decode_chunk(void* arg) {
+    BenchDecChunk* c = arg;
+    INT16* preroll = malloc((size_t)(c->first - c->start) * LPC10_SAMPLES_PER_FRAME * sizeof(INT16) + 1);
+
+    lpc10_decode_s16(c->bytes + (size_t)c->start * LPC10_BYTES_IN_COMPRESSED_FRAME,
+                     (c->first - c->start) * LPC10_BYTES_IN_COMPRESSED_FRAME, preroll, 0, &c->dec);
+    lpc10_decode_s16(c->bytes + (size_t)c->first * LPC10_BYTES_IN_COMPRESSED_FRAME, c->nframes * LPC10_BYTES_IN_COMPRESSED_FRAME,
+                     c->out, 0, &c->dec);
+    free(preroll);
+    return NULL;
+}
+
+/*
+ * Encodes the corpus in one piece and in `threads` chunks encoded at once,
+ * each on its own thread, then decodes the stream the same two ways, and
+ * prints how the times and the results compare.  Returns the number of
+ * frames the chunked encoding has that differ.
+ */
+static int chunk_check(const real* corpus, int frames, int threads) {
+    const int nsamples = frames * LPC10_SAMPLES_PER_FRAME;
+    const int per = (frames + threads - 1) / threads;
+    INT16* pcm = malloc((size_t)nsamples * sizeof(INT16));
+    unsigned char* whole = malloc((size_t)frames * LPC10_BYTES_IN_COMPRESSED_FRAME);
+    unsigned char* chunked = malloc((size_t)frames * LPC10_BYTES_IN_COMPRESSED_FRAME);
+    BenchChunk* chunks = calloc((size_t)threads, sizeof(BenchChunk));
+    pthread_t* tids = calloc((size_t)threads, sizeof(pthread_t));
+    struct lpc10_encoder_state* enc = create_lpc10_encoder_state();
+    int differ = 0;
+
+    for (int i = 0; i < nsamples; ++i) {
+        real s = corpus[i] * 32768.f;
+        pcm[i] = s > 32767.f ? 32767 : s < -32768.f ? -32768 : (INT16)lrintf(s);
+    }
+
+    uint64_t t0 = now_ns();
+    lpc10_encode_s16(pcm, nsamples, whole, 0, enc);
+    uint64_t t1 = now_ns();
+    for (int k = 0; k < threads; ++k) {
+        int first = k * per < frames ? k * per : frames;
+        int last = first + per < frames ? first + per : frames;
+        chunks[k] = (BenchChunk){pcm, nsamples, first, last - first, chunked + (size_t)first * LPC10_BYTES_IN_COMPRESSED_FRAME};
+        pthread_create(&tids[k], NULL, encode_chunk, &chunks[k]);
+    }
+    for (int k = 0; k < threads; ++k)
+        pthread_join(tids[k], NULL);
+    uint64_t t2 = now_ns();
+
+    for (int i = 0; i < frames; ++i)
+        differ += memcmp(whole + (size_t)i * LPC10_BYTES_IN_COMPRESSED_FRAME, chunked + (size_t)i * LPC10_BYTES_IN_COMPRESSED_FRAME,
+                         LPC10_BYTES_IN_COMPRESSED_FRAME) != 0;
+
+    printf("frames:        %d (%.1f s of audio) in %d chunks, %d frames of warm-up, %d of pre-roll\n", frames,
+           frames * LPC10_SAMPLES_PER_FRAME / 8000.0, threads, LPC10_CHUNK_WARMUP, LPC10_CHUNK_PREROLL);
+    printf("encode:        %.0f ms sequential, %.0f ms chunked, %.2fx speedup\n", (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+           (double)(t1 - t0) / (t2 - t1));
+    printf("encode differ: %d frames (%.3f%%)\n", differ, 100.0 * differ / frames);
+
+    // Decoding the sequential stream: the calling thread skips ahead and starts each chunk in turn
+    INT16* out = malloc((size_t)nsamples * sizeof(INT16));
+    INT16* out_chunked = malloc((size_t)nsamples * sizeof(INT16));
+    BenchDecChunk* dchunks = calloc((size_t)threads, sizeof(BenchDecChunk));
+    struct lpc10_decoder_state* dec = create_lpc10_decoder_state();
+    int pos = 0;
+
+    t0 = now_ns();
+    lpc10_decode_s16(whole, frames * LPC10_BYTES_IN_COMPRESSED_FRAME, out, 0, dec);
+    t1 = now_ns();
+    init_lpc10_decoder_state(dec);
+    for (int k = 0; k < threads; ++k) {
+        int first = k * per < frames ? k * per : frames;
+        int last = first + per < frames ? first + per : frames;
+        int start = first > LPC10_CHUNK_PREROLL ? first - LPC10_CHUNK_PREROLL : 0;
+
+        lpc10_decode_skip(whole + (size_t)pos * LPC10_BYTES_IN_COMPRESSED_FRAME, start - pos, 0, dec);
+        pos = start;
+        dchunks[k] = (BenchDecChunk){whole, start, first, last - first, *dec, out_chunked + (size_t)first * LPC10_SAMPLES_PER_FRAME};
+        pthread_create(&tids[k], NULL, decode_chunk, &dchunks[k]);
+    }
+    for (int k = 0; k < threads; ++k)
+        pthread_join(tids[k], NULL);
+    t2 = now_ns();
+
+    int decode_differ = 0;
+    for (int i = 0; i < frames; ++i)
+        decode_differ += memcmp(out + (size_t)i * LPC10_SAMPLES_PER_FRAME, out_chunked + (size_t)i * LPC10_SAMPLES_PER_FRAME,
+                                LPC10_SAMPLES_PER_FRAME * sizeof(INT16)) != 0;
+    printf("decode:        %.0f ms sequential, %.0f ms chunked, %.2fx speedup\n", (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+           (double)(t1 - t0) / (t2 - t1));
+    printf("decode differ: %d frames (%.3f%%)\n", decode_differ, 100.0 * decode_differ / frames);
+
+    free(dec);
+    free(dchunks);
+    free(out_chunked);
+    free(out);
+
+    free(enc);
+    free(tids);
+    free(chunks);
+    free(chunked);
+    free(whole);
+    free(pcm);
+    return differ;
+}
+
+#ifdef LPC10_PROFILE
+/* Prints the stages first to last of `prof`, per frame and as a share of their total. */
+static void print_profile(const char* what, const struct lpc10_profile* prof, int first, int last, int frames) {
+    double total = 0;
+
+    for (int i = first; i <= last; ++i)
+        total += (double)prof->ticks[i];
+    printf("%s stages (%s/frame, calls/frame, share):\n", what, lpc10_profile_unit());
+    for (int i = first; i <= last; ++i)
+        printf("  %-8s %10.0f %7.2f %6.1f%%\n", lpc10_profile_name(i), (double)prof->ticks[i] / frames,
+               (double)prof->calls[i] / frames, total > 0 ? 100.0 * (double)prof->ticks[i] / total : 0.0);
+}
+#endif
+
+int main(int argc, char** argv) {
+    int frames = 20000, silence_pct = 60, repeats = 3, opt;
+    double drift_hours = 0;
+    int check_latency = 0, chunk_threads = 0, fuzz_iterations = 0;
+    real* corpus;
+
+    while ((opt = getopt(argc, argv, "n:s:r:d:lp:f:")) != -1) {
+        switch (opt) {
+            case 'n':
+                frames = atoi(optarg);
+                break;
+            case 's':
+                silence_pct = atoi(optarg);
+                break;
+            case 'r':
+                repeats = atoi(optarg);
+                break;
+            case 'd':
+                drift_hours = atof(optarg);
+                break;
+            case 'l':
+                check_latency = 1;
+                break;
+            case 'p':
+                chunk_threads = atoi(optarg);
+                break;
+            case 'f':
+                fuzz_iterations = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n frames] [-s silence-percent] [-r repeats] [-d hours] [-l] [-p threads] [-f iterations] [file.raw]\n",
+                        argv[0]);
+                return 2;
+        }
+    }
+
+    if (check_latency)
+        return latency_check() != 0;
+
+    if (optind < argc) {
+        corpus = load_raw(argv[optind], &frames);
+        if (!corpus)
+            return 1;
+    } else {
+        corpus = malloc((size_t)frames * LPC10_SAMPLES_PER_FRAME * sizeof(real));
+        make_corpus(corpus, frames, silence_pct);
+    }
+
+    if (drift_hours > 0) {
+        double worst = drift_check(corpus, frames, drift_hours);
+        if (worst < 0)
+            printf("onset drift:   FPC values differ from the encoder's, no reference\n");
+        else
+            printf("onset drift:   %.3g max over %.1f h (limit %g)\n", worst, drift_hours, BENCH_DRIFT_LIMIT);
+        free(corpus);
+        return worst < 0 || worst > BENCH_DRIFT_LIMIT;
+    }
+
+    if (fuzz_iterations > 0) {
+        int failed = restore_fuzz(corpus, frames, fuzz_iterations);
+        free(corpus);
+        return failed != 0;
+    }
+
+    if (chunk_threads > 0) {
+        // Reported, not a failure: a few differing frames are expected
+        chunk_check(corpus, frames, chunk_threads);
+        free(corpus);
+        return 0;
+    }
+
+    INT32* bits = malloc((size_t)frames * LPC10_BITS_IN_COMPRESSED_FRAME * sizeof(INT32));
+    real speech[LPC10_SAMPLES_PER_FRAME];
+    uint64_t enc_best = UINT64_MAX, dec_best = UINT64_MAX;
+    long silent = 0;
+#ifdef LPC10_PROFILE
+    struct lpc10_profile enc_prof, dec_prof;
+#endif
+
+    for (int r = 0; r < repeats; ++r) {
+        struct lpc10_encoder_state* enc = create_lpc10_encoder_state();
+        struct lpc10_decoder_state* dec = create_lpc10_decoder_state();
+        uint64_t t0 = now_ns();
+        for (int i = 0; i < frames; ++i) {
+            memcpy(speech, corpus + (size_t)i * LPC10_SAMPLES_PER_FRAME, sizeof(speech));
+            lpc10_encode(speech, bits + (size_t)i * LPC10_BITS_IN_COMPRESSED_FRAME, enc);
+        }
+        uint64_t t1 = now_ns();
+        silent = 0;
+        for (int i = 0; i < frames; ++i) {
+            lpc10_decode(bits + (size_t)i * LPC10_BITS_IN_COMPRESSED_FRAME, speech, dec);
+            silent += dec->silent != 0;
+        }
+        uint64_t t2 = now_ns();
+        if (t1 - t0 < enc_best)
+            enc_best = t1 - t0;
+        if (t2 - t1 < dec_best)
+            dec_best = t2 - t1;
+#ifdef LPC10_PROFILE
+        enc_prof = enc->prof;
+        dec_prof = dec->prof;
+#endif
+        free(enc);
+        free(dec);
+    }
+
+    printf("frames:        %d (%.1f s of audio)\n", frames, frames * LPC10_SAMPLES_PER_FRAME / 8000.0);
+    printf("encode:        %.0f ns/frame, %.0fx real time\n", (double)enc_best / frames, frames * 22.5e6 / enc_best);
+    printf("decode:        %.0f ns/frame, %.0fx real time\n", (double)dec_best / frames, frames * 22.5e6 / dec_best);
+    printf("silence path:  %ld frames (%.1f%%)\n", silent, 100.0 * silent / frames);
+#ifdef LPC10_PROFILE
+    if (repeats > 0) {
+        print_profile("analysis", &enc_prof, LPC10_PROF_LPFILT, LPC10_PROF_INVERT, frames);
+        print_profile("synthesis", &dec_prof, LPC10_PROF_PITSYN, LPC10_PROF_DEEMP, frames);
+    }
+#endif
+
+    free(bits);
+    free(corpus);
+    return 0;
+}
@@ -0,0 +1,902 @@
+/*
+ * lpc10-cli - offline LPC10 transcoder.
+ *
+ * Encodes S16LE 8 kHz mono speech (raw, or a WAV file in that format) to an
+ * LPC10 stream as lpc10enc writes it, or decodes such a stream back to raw
+ * samples or a WAV file.  Input files are memory-mapped and run through
+ * lpc10_encode_s16() / lpc10_decode_s16() a batch of frames at a time, and
+ * the output is written in large blocks, so a file costs one thread and no
+ * per-frame copies.  Several files are transcoded at once, one per thread.
+ *
+ * With -p, each file is instead split into chunks that are transcoded at
+ * once, one per thread, so that a long recording uses all cores.  Encoding,
+ * each chunk starts after LPC10_CHUNK_WARMUP frames (or -W frames) of
+ * warm-up, and some frames after the chunk starts may differ from a
+ * sequential encoding (see lpc10.h).  Decoding, the calling thread skips
+ * through the stream with lpc10_decode_skip() and hands each chunk the
+ * decoder state at its start, which after LPC10_CHUNK_PREROLL frames (or
+ * -W frames) of pre-roll gives the samples of a sequential decoding.
+ *
+ * With -C, the stream is written in the seekable LPC-10 file format
+ * (lpc10/lpcfile.c): a header, then every LPC10_FILE_SYNC_FRAMES frames a
+ * sync point holding the decoder state, and an index of the sync points at
+ * the end, which lpc10parse seeks with.  -R writes existing streams in it.
+ * Decoding recognizes such files, and with -p starts each chunk at a sync
+ * point from its state, without skipping or pre-roll.
+ *
+ * Usage: lpc10-cli [-d] [-t] [-w] [-L] [-C] [-R] [-p] [-W frames] [-j jobs] [-o output] input...
+ *   -d  decode instead of encode
+ *   -t  packing=tight streams (4 frames in 27 bytes) instead of 7-byte frames
+ *   -w  with -d, write WAV files instead of raw samples
+ *   -L  encode with the low-delay analysis (as lpc10enc low-delay=true)
+ *   -C  encode to the seekable LPC-10 file format
+ *   -R  rewrite LPC10 streams (as lpc10enc writes them) in the file format
+ *   -p  transcode each file in chunks on all -j threads, one file at a time
+ *   -W  frames of warm-up (encoding) or pre-roll (decoding) before each
+ *       chunk with -p
+ *   -j  files transcoded at once (default: one per online CPU), or chunk
+ *       threads with -p
+ *   -o  output file for a single input, or directory for several; by default
+ *       each output goes next to its input, with the extension replaced by
+ *       .lpc10, .raw or .wav
+ */
+
+#define _DEFAULT_SOURCE  // mmap(), madvise(), sysconf() and getopt() under -std=c17
+
+#include "lpc10.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CLI_BATCH_FRAMES 4096          // Frames per lpc10_*_s16() call, 92 s of speech
+#define CLI_WRITE_BYTES (1024 * 1024)  // Output is written in blocks of at least this size
+#define CLI_WAV_HEADER 44
+#define CLI_MIN_CHUNK_FRAMES 4000  // 90 s; -p does not split a file into chunks shorter than this, so warm-up stays ~5%
+
+typedef struct {
+    int decode;
+    int tight;
+    int wav;
+    int low_delay;
+    int file_format;  // -C or -R
+    int rewrap;       // -R
+    int chunked;  // -p
+    int warmup;   // -W, or -1 for the default
+    int threads;  // Chunk threads with -p
+    const char* output;  // -o, NULL if not given
+    int output_is_dir;
+} CliOptions;
+
+typedef struct {
+    const CliOptions* opts;
+    char** inputs;
+    int count;
+    atomic_int next;    // Index of the next input to be picked up by a worker
+    atomic_int failed;  // Number of inputs that could not be transcoded
+} CliJobs;
+
+/* A sync point of an LPC-10 file, and the frames after it. */
+typedef struct {
+    size_t frame;               // Number of the first frame
+    size_t nframes;
+    const unsigned char* sync;  // The sync point
+    int sync_bytes;
+    const unsigned char* data;  // The frames
+} CliSection;
+
+/* A chunk of a file transcoded by -p, for the thread that transcodes it. */
+typedef struct {
+    const CliOptions* opts;
+    const unsigned char* data;  // S16LE samples or the stream of the whole file
+    size_t nsamples;            // Encoding, samples in data
+    size_t first;               // First frame of the chunk, a multiple of LPC10_TIGHT_FRAMES
+    size_t end;                 // Frame after its last one
+    size_t start;               // Decoding, frame the pre-roll starts at, a multiple of LPC10_TIGHT_FRAMES
+    struct lpc10_decoder_state* dec;  // Decoding, the state at frame start as lpc10_decode_skip() leaves it
+    off_t base;                 // Offset of frame 0 in the output
+    int fd;
+    int threaded;  // Transcoded on a thread of its own
+    int ret;
+    const CliSection* sections;  // Decoding an LPC-10 file, the sync points of the chunk
+    size_t nsections;
+} CliChunk;
+
+/* A memory-mapped input file. */
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+} CliMap;
+
+/* An output file and the block of output not yet written to it. */
+typedef struct {
+    int fd;
+    unsigned char* buf;
+    size_t len;
+} CliOut;
+
+/* The memory from an allocation, which the tool cannot go on without: exits with an error if there is none. */
+static void* check_alloc(void* p) {
+    if (!p) {
+        fprintf(stderr, "lpc10-cli: %s\n", strerror(ENOMEM));
+        exit(1);
+    }
+    return p;
+}
+
+/* Maps the file open on fd, named path in messages. */
+static int map_fd(const char* path, int fd, CliMap* map) {
+    struct stat sb;
+
+    if (fstat(fd, &sb) < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    map->size = (size_t)sb.st_size;
+    map->data = NULL;
+    if (map->size > 0) {
+        void* p = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            return -1;
+        }
+        madvise(p, map->size, MADV_SEQUENTIAL);
+        map->data = p;
+    }
+    return 0;
+}
+
+static int map_file(const char* path, CliMap* map) {
+    int fd = open(path, O_RDONLY);
+    int ret;
+
+    if (fd < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    ret = map_fd(path, fd, map);
+    close(fd);
+    return ret;
+}
+
+static void unmap_file(CliMap* map) {
+    if (map->data)
+        munmap((void*)map->data, map->size);
+}
+
+static uint32_t le32(const unsigned char* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void put_le32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+/*
+ * Finds the samples of `map`: the data chunk of a WAV file, which has to be
+ * 16-bit PCM, 8 kHz and mono, or else the whole file as raw S16LE.  Returns
+ * -1 for a WAV file in any other format.
+ */
+static int find_samples(const char* path, const CliMap* map, const unsigned char** data, size_t* size) {
+    size_t pos = 12;
+    int have_fmt = 0;
+
+    *data = map->data;
+    *size = map->size;
+    if (map->size < 12 || memcmp(map->data, "RIFF", 4) != 0 || memcmp(map->data + 8, "WAVE", 4) != 0)
+        return 0;
+
+    while (pos + 8 <= map->size) {
+        const unsigned char* chunk = map->data + pos;
+        size_t len = le32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && len >= 16 && pos + 8 + 16 <= map->size) {
+            unsigned format = chunk[8] | chunk[9] << 8, channels = chunk[10] | chunk[11] << 8;
+            unsigned bits = chunk[22] | chunk[23] << 8;
+            if (format != 1 || channels != 1 || le32(chunk + 12) != 8000 || bits != 16) {
+                fprintf(stderr, "%s: not 16-bit PCM, 8000 Hz, mono; convert it first (e.g. with sox)\n", path);
+                return -1;
+            }
+            have_fmt = 1;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!have_fmt)
+                break;
+            *data = chunk + 8;
+            // A streamed WAV file may leave the size at 0 or 0xffffffff
+            *size = len == 0 || len > map->size - pos - 8 ? map->size - pos - 8 : len;
+            return 0;
+        }
+        pos += 8 + len + (len & 1);
+    }
+    fprintf(stderr, "%s: WAV file without a format and data chunk\n", path);
+    return -1;
+}
+
+static int out_flush(CliOut* out) {
+    size_t done = 0;
+
+    while (done < out->len) {
+        ssize_t n = write(out->fd, out->buf + done, out->len - done);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        done += (size_t)n;
+    }
+    out->len = 0;
+    return 0;
+}
+
+/* Makes the output path for `input`: in the -o directory if given, with the extension replaced by `ext`. */
+static char* output_path(const CliOptions* opts, const char* input, const char* ext) {
+    const char* base = strrchr(input, '/');
+    const char* dot;
+    size_t dir_len = 0, stem_len;
+    char* path;
+
+    if (opts->output && !opts->output_is_dir)
+        return check_alloc(strdup(opts->output));
+
+    base = base ? base + 1 : input;
+    if (opts->output)
+        dir_len = strlen(opts->output) + 1;
+    else
+        dir_len = (size_t)(base - input);
+    dot = strrchr(base, '.');
+    stem_len = dot && dot != base ? (size_t)(dot - base) : strlen(base);
+
+    path = check_alloc(malloc(dir_len + stem_len + strlen(ext) + 1));
+    if (opts->output)
+        sprintf(path, "%s/", opts->output);
+    else
+        memcpy(path, input, dir_len);
+    memcpy(path + dir_len, base, stem_len);
+    strcpy(path + dir_len + stem_len, ext);
+    return path;
+}
+
+static void load_s16le(INT16* pcm, const unsigned char* p, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        pcm[i] = (INT16)(p[2 * i] | p[2 * i + 1] << 8);
+}
+
+/* Bytes frames 0 through frames-1 take in the output stream; frames has to be a multiple of 4 if tight. */
+static off_t stream_bytes(size_t frames, int tight) {
+    return tight ? (off_t)(frames / LPC10_TIGHT_FRAMES * LPC10_TIGHT_BYTES) : (off_t)(frames * LPC10_BYTES_IN_COMPRESSED_FRAME);
+}
+
+static int pwrite_all(int fd, const unsigned char* buf, size_t len, off_t offset) {
+    while (len > 0) {
+        ssize_t n = pwrite(fd, buf, len, offset);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+        offset += n;
+    }
+    return 0;
+}
+
+/*
+ * Encodes one chunk for -p, a batch at a time, and writes each batch at its
+ * place in the output. The first batch goes through lpc10_encode_chunk() to
+ * warm the encoder up; the others continue from its state.
+ */
+static void* encode_chunk(void* arg) {
+    CliChunk* c = arg;
+    const size_t warmup = (size_t)c->opts->warmup;
+    struct lpc10_encoder_state* st = check_alloc(create_lpc10_encoder_state());
+    INT16* pcm = check_alloc(malloc((CLI_BATCH_FRAMES + warmup + LPC10_TIGHT_FRAMES) * LPC10_SAMPLES_PER_FRAME * sizeof(INT16)));
+    unsigned char* bytes = check_alloc(malloc(CLI_BATCH_FRAMES * LPC10_BYTES_IN_COMPRESSED_FRAME));
+    size_t f = c->first;
+
+    st->lowdelay = c->opts->low_delay;
+    c->ret = 0;
+    while (f < c->end && c->ret == 0) {
+        size_t batch = c->end - f < CLI_BATCH_FRAMES ? c->end - f : CLI_BATCH_FRAMES;
+        // The warm-up starts on a tight block, which also keeps the parity the sync bit needs
+        size_t base = f == c->first ? (f - (f < warmup ? f : warmup)) / LPC10_TIGHT_FRAMES * LPC10_TIGHT_FRAMES : f;
+        size_t s0 = base * LPC10_SAMPLES_PER_FRAME, s1 = (f + batch) * LPC10_SAMPLES_PER_FRAME;
+        int n, len;
+
+        if (s1 > c->nsamples)
+            s1 = c->nsamples;
+        n = s1 > s0 ? (int)(s1 - s0) : 0;
+        load_s16le(pcm, c->data + s0 * 2, (size_t)n);
+        if (f == c->first)
+            len = lpc10_encode_chunk(pcm, n, (int)(f - base), (int)batch, (int)warmup, bytes, c->opts->tight, st);
+        else
+            len = lpc10_encode_s16(pcm, n, bytes, c->opts->tight, st);
+        if (pwrite_all(c->fd, bytes, (size_t)len, stream_bytes(f, c->opts->tight)) < 0)
+            c->ret = -1;
+        f += batch;
+    }
+    free(bytes);
+    free(pcm);
+    free(st);
+    return NULL;
+}
+
+/* Frames per chunk for -p: whole tight blocks, one chunk per thread as long as they are not too short. */
+static size_t chunk_frames(const CliOptions* opts, size_t frames) {
+    size_t nchunks = frames / CLI_MIN_CHUNK_FRAMES;
+
+    if (nchunks > (size_t)opts->threads)
+        nchunks = (size_t)opts->threads;
+    if (nchunks < 1)
+        nchunks = 1;
+    return (frames / nchunks + LPC10_TIGHT_FRAMES - 1) / LPC10_TIGHT_FRAMES * LPC10_TIGHT_FRAMES;
+}
+
+/* Encodes the samples of one input for -p: in chunks of whole tight blocks, one per thread. */
+static int encode_chunked(const CliOptions* opts, const unsigned char* data, size_t size, int fd) {
+    size_t nsamples = size / 2;
+    size_t frames = (nsamples + LPC10_SAMPLES_PER_FRAME - 1) / LPC10_SAMPLES_PER_FRAME;
+    size_t nchunks, per;
+    CliChunk* chunks;
+    pthread_t* threads;
+    int ret = 0;
+
+    frames = (frames + LPC10_TIGHT_FRAMES - 1) / LPC10_TIGHT_FRAMES * LPC10_TIGHT_FRAMES;
+    per = chunk_frames(opts, frames);
+    nchunks = (frames + per - 1) / per;
+    if (!opts->tight) {
+        // Only tight streams are padded to a whole block
+        frames = (nsamples + LPC10_SAMPLES_PER_FRAME - 1) / LPC10_SAMPLES_PER_FRAME;
+    }
+    if (ftruncate(fd, stream_bytes(frames, opts->tight)) < 0)
+        return -1;
+
+    chunks = check_alloc(calloc(nchunks, sizeof(CliChunk)));
+    threads = check_alloc(calloc(nchunks, sizeof(pthread_t)));
+    for (size_t i = 0; i < nchunks; ++i) {
+        chunks[i] = (CliChunk){opts, data, nsamples, i * per, (i + 1) * per < frames ? (i + 1) * per : frames, 0, NULL, 0, fd, 0, 0, NULL, 0};
+        if (chunks[i].first >= chunks[i].end) {
+            nchunks = i;
+            break;
+        }
+    }
+    // The calling thread encodes the first chunk; a chunk whose thread cannot be started is encoded there too
+    for (size_t i = 1; i < nchunks; ++i) {
+        chunks[i].threaded = pthread_create(&threads[i], NULL, encode_chunk, &chunks[i]) == 0;
+        if (!chunks[i].threaded)
+            encode_chunk(&chunks[i]);
+    }
+    encode_chunk(&chunks[0]);
+    for (size_t i = 0; i < nchunks; ++i) {
+        if (chunks[i].threaded)
+            pthread_join(threads[i], NULL);
+        if (chunks[i].ret < 0)
+            ret = -1;
+    }
+    free(threads);
+    free(chunks);
+    return ret;
+}
+
+/*
+ * Decodes one chunk for -p from the state it was handed: the pre-roll is
+ * decoded and dropped, then the chunk is decoded a batch at a time and each
+ * batch written at its place in the output.
+ */
+static void* decode_chunk(void* arg) {
+    CliChunk* c = arg;
+    const int tight = c->opts->tight;
+    INT16* pcm = check_alloc(malloc(CLI_BATCH_FRAMES * LPC10_SAMPLES_PER_FRAME * sizeof(INT16)));
+    unsigned char* bytes = check_alloc(malloc(CLI_BATCH_FRAMES * LPC10_SAMPLES_PER_FRAME * sizeof(INT16)));
+    size_t f = c->start;
+
+    c->ret = 0;
+    while (f < c->end && c->ret == 0) {
+        // The pre-roll goes in batches of its own, so none of its samples are written
+        size_t stop = f < c->first ? c->first : c->end;
+        size_t batch = stop - f < CLI_BATCH_FRAMES ? stop - f : CLI_BATCH_FRAMES;
+        int n = lpc10_decode_s16(c->data + stream_bytes(f, tight), (int)stream_bytes(batch, tight), pcm, tight, c->dec);
+
+        if (f >= c->first) {
+            for (int i = 0; i < n; ++i) {
+                bytes[2 * i] = (unsigned char)pcm[i];
+                bytes[2 * i + 1] = (unsigned char)((uint16_t)pcm[i] >> 8);
+            }
+            if (pwrite_all(c->fd, bytes, (size_t)n * 2, c->base + (off_t)(f * LPC10_SAMPLES_PER_FRAME * sizeof(INT16))) < 0)
+                c->ret = -1;
+        }
+        f += batch;
+    }
+    free(bytes);
+    free(pcm);
+    return NULL;
+}
+
+/*
+ * Decodes the frames of one input for -p, with frame 0 at offset base of the output. The calling
+ * thread skips through the stream and starts each chunk's thread as soon as it has its state, so
+ * the skipping, about a fifth of the cost of decoding, overlaps the decoding of the chunks before.
+ */
+static int decode_chunked(const CliOptions* opts, const unsigned char* data, size_t size, int fd, off_t base) {
+    size_t frames = opts->tight ? size / LPC10_TIGHT_BYTES * LPC10_TIGHT_FRAMES : size / LPC10_BYTES_IN_COMPRESSED_FRAME;
+    size_t preroll = (size_t)opts->warmup;
+    size_t per = chunk_frames(opts, frames), nchunks = (frames + per - 1) / per, pos = 0;
+    struct lpc10_decoder_state* st = check_alloc(create_lpc10_decoder_state());
+    CliChunk* chunks = check_alloc(calloc(nchunks, sizeof(CliChunk)));
+    pthread_t* threads = check_alloc(calloc(nchunks, sizeof(pthread_t)));
+    int ret = 0;
+
+    if (ftruncate(fd, base + (off_t)(frames * LPC10_SAMPLES_PER_FRAME * sizeof(INT16))) < 0)
+        ret = -1;
+    for (size_t i = 0; i < nchunks && ret == 0; ++i) {
+        size_t first = i * per, end = first + per < frames ? first + per : frames;
+        size_t start = (first - (first < preroll ? first : preroll)) / LPC10_TIGHT_FRAMES * LPC10_TIGHT_FRAMES;
+
+        lpc10_decode_skip(data + stream_bytes(pos, opts->tight), (int)(start - pos), opts->tight, st);
+        pos = start;
+        chunks[i] = (CliChunk){opts, data, 0, first, end, start, check_alloc(malloc(sizeof(*st))), base, fd, 0, 0, NULL, 0};
+        *chunks[i].dec = *st;
+        chunks[i].threaded = pthread_create(&threads[i], NULL, decode_chunk, &chunks[i]) == 0;
+        if (!chunks[i].threaded)
+            decode_chunk(&chunks[i]);
+    }
+    for (size_t i = 0; i < nchunks; ++i) {
+        if (chunks[i].threaded)
+            pthread_join(threads[i], NULL);
+        if (chunks[i].ret < 0)
+            ret = -1;
+        free(chunks[i].dec);
+    }
+    free(threads);
+    free(chunks);
+    free(st);
+    return ret;
+}
+
+/*
+ * Decodes the sync points of one chunk of an LPC-10 file for -p: from the
+ * state of the first, each one's frames decoded as a chunk of their own.
+ */
+static void* decode_sections(void* arg) {
+    CliChunk* c = arg;
+    const CliSection* sec = c->sections;
+    const off_t base = c->base;
+
+    lpc10_decoder_state_restore(c->dec, sec->sync + LPC10_FILE_SYNC_HEAD, sec->sync_bytes - LPC10_FILE_SYNC_HEAD);
+    c->ret = 0;
+    for (size_t i = 0; i < c->nsections && c->ret == 0; ++i, ++sec) {
+        c->data = sec->data;
+        c->first = c->start = 0;
+        c->end = sec->nframes;
+        c->base = base + (off_t)(sec->frame * LPC10_SAMPLES_PER_FRAME * sizeof(INT16));
+        decode_chunk(c);
+    }
+    return NULL;
+}
+
+/*
+ * Decodes the sync points of an LPC-10 file for -p, with frame 0 at offset base of the output:
+ * in chunks of whole sync points, each from the state its first one holds, so unlike
+ * decode_chunked() nothing is left to the calling thread and no pre-roll is decoded.
+ */
+static int decode_file_chunked(const CliOptions* opts, const CliSection* sections, size_t count, int fd, off_t base) {
+    size_t frames = count > 0 ? sections[count - 1].frame + sections[count - 1].nframes : 0;
+    size_t per = chunk_frames(opts, frames), nchunks = 0;
+    CliChunk* chunks = check_alloc(calloc(count, sizeof(CliChunk)));
+    pthread_t* threads = check_alloc(calloc(count, sizeof(pthread_t)));
+    int ret = 0;
+
+    if (ftruncate(fd, base + (off_t)(frames * LPC10_SAMPLES_PER_FRAME * sizeof(INT16))) < 0)
+        ret = -1;
+    for (size_t i = 0, j; i < count && ret == 0; i = j, ++nchunks) {
+        for (j = i + 1; j < count && sections[j].frame < sections[i].frame + per; ++j)
+            ;
+        chunks[nchunks] = (CliChunk){opts, NULL, 0, 0, 0, 0, check_alloc(create_lpc10_decoder_state()), base, fd, 0, 0, sections + i, j - i};
+        chunks[nchunks].threaded = pthread_create(&threads[nchunks], NULL, decode_sections, &chunks[nchunks]) == 0;
+        if (!chunks[nchunks].threaded)
+            decode_sections(&chunks[nchunks]);
+    }
+    for (size_t i = 0; i < nchunks; ++i) {
+        if (chunks[i].threaded)
+            pthread_join(threads[i], NULL);
+        if (chunks[i].ret < 0)
+            ret = -1;
+        free(chunks[i].dec);
+    }
+    free(threads);
+    free(chunks);
+    return ret;
+}
+
+/* Encodes the samples of one input into out, a batch at a time. */
+static int encode_samples(const CliOptions* opts, const unsigned char* data, size_t size, CliOut* out) {
+    struct lpc10_encoder_state* st = check_alloc(create_lpc10_encoder_state());
+    INT16* pcm = check_alloc(malloc(CLI_BATCH_FRAMES * LPC10_SAMPLES_PER_FRAME * sizeof(INT16)));
+    size_t nsamples = size / 2, done = 0;
+    int ret = 0;
+
+    st->lowdelay = opts->low_delay;
+    while (done < nsamples) {
+        int n = (int)(nsamples - done < CLI_BATCH_FRAMES * LPC10_SAMPLES_PER_FRAME ? nsamples - done
+                                                                                   : CLI_BATCH_FRAMES * LPC10_SAMPLES_PER_FRAME);
+        const unsigned char* p = data + done * 2;
+
+        load_s16le(pcm, p, (size_t)n);
+        if (out->len + LPC10_ENCODED_BYTES(n, opts->tight) > CLI_WRITE_BYTES && out_flush(out) < 0) {
+            ret = -1;
+            break;
+        }
+        out->len += (size_t)lpc10_encode_s16(pcm, n, out->buf + out->len, opts->tight, st);
+        done += (size_t)n;
+    }
+    free(pcm);
+    free(st);
+    return ret;
+}
+
+/* Decodes the frames of one input into out with the decoder st, a batch at a time. */
+static int decode_frames(const CliOptions* opts, const unsigned char* data, size_t size, struct lpc10_decoder_state* st,
+                         CliOut* out) {
+    const size_t unit = opts->tight ? LPC10_TIGHT_BYTES : LPC10_BYTES_IN_COMPRESSED_FRAME;
+    const size_t batch = CLI_BATCH_FRAMES / LPC10_TIGHT_FRAMES * unit;  // A whole number of units either way
+    INT16* pcm = check_alloc(malloc(CLI_BATCH_FRAMES * LPC10_SAMPLES_PER_FRAME * sizeof(INT16)));
+    size_t done = 0, end = size / unit * unit;
+    int ret = 0;
+
+    while (done < end) {
+        int nbytes = (int)(end - done < batch ? end - done : batch);
+        int n = lpc10_decode_s16(data + done, nbytes, pcm, opts->tight, st);
+
+        if (out->len + (size_t)n * 2 > CLI_WRITE_BYTES && out_flush(out) < 0) {
+            ret = -1;
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            out->buf[out->len++] = (unsigned char)pcm[i];
+            out->buf[out->len++] = (unsigned char)((uint16_t)pcm[i] >> 8);
+        }
+        done += (size_t)nbytes;
+    }
+    free(pcm);
+    return ret;
+}
+
+/*
+ * Finds the sync points of an LPC-10 file, up to its index. A file cut short, e.g. by a crash
+ * while it was written, gives the whole frames it has. Returns how many there are, or -1 if
+ * the file is damaged.
+ */
+static long read_sections(const char* path, const unsigned char* data, size_t size, int tight, CliSection** sections) {
+    const size_t unit = tight ? LPC10_TIGHT_BYTES : LPC10_BYTES_IN_COMPRESSED_FRAME;
+    size_t pos = LPC10_FILE_HEADER_BYTES, frame = 0, count = 0, max = 0;
+    CliSection* secs = NULL;
+
+    while (pos < size) {
+        int avail = size - pos > INT_MAX ? INT_MAX : (int)(size - pos);
+        long long first;
+        int nframes, len = lpc10_file_sync_read(&first, &nframes, NULL, data + pos, avail);
+        size_t whole;
+
+        if (len == 0 || (len < 0 && lpc10_file_index_read(NULL, 0, data + pos, avail) >= 0))
+            break;
+        if (len < 0 || (size_t)first != frame) {
+            fprintf(stderr, "%s: damaged LPC-10 file at offset %zu\n", path, pos);
+            free(secs);
+            return -1;
+        }
+        if (count == max) {
+            max = max ? 2 * max : 64;
+            secs = check_alloc(realloc(secs, max * sizeof(CliSection)));
+        }
+        pos += (size_t)len;
+        whole = (size - pos) / unit * (tight ? LPC10_TIGHT_FRAMES : 1);
+        secs[count] = (CliSection){frame, (size_t)nframes < whole ? (size_t)nframes : whole, data + pos - len, len, data + pos};
+        pos += (size_t)stream_bytes(secs[count].nframes, tight);
+        frame += secs[count].nframes;
+        if (secs[count++].nframes < (size_t)nframes)
+            break;
+    }
+    *sections = secs;
+    return (long)count;
+}
+
+/*
+ * Writes the frames of a stream to out in the LPC-10 file format: a sync point every
+ * LPC10_FILE_SYNC_FRAMES frames, with the state of a decoder run alongside, then the index,
+ * and last the header again, now with the number of frames and the offset of the index.
+ */
+static int write_file_format(const CliOptions* opts, const unsigned char* stream, size_t size, CliOut* out) {
+    const int tight = opts->tight;
+    size_t frames = tight ? size / LPC10_TIGHT_BYTES * LPC10_TIGHT_FRAMES : size / LPC10_BYTES_IN_COMPRESSED_FRAME;
+    size_t count = (frames + LPC10_FILE_SYNC_FRAMES - 1) / LPC10_FILE_SYNC_FRAMES;
+    struct lpc10_file_header h = {tight, 8000, -1, 0};
+    struct lpc10_file_sync* syncs = check_alloc(malloc((count + 1) * sizeof(struct lpc10_file_sync)));
+    unsigned char* index = check_alloc(malloc(LPC10_FILE_INDEX_BYTES(count)));
+    struct lpc10_decoder_state* st = check_alloc(create_lpc10_decoder_state());
+    INT16* pcm = check_alloc(malloc(LPC10_FILE_SYNC_FRAMES * LPC10_SAMPLES_PER_FRAME * sizeof(INT16)));
+    unsigned char header[LPC10_FILE_HEADER_BYTES];
+    off_t pos = lpc10_file_header_write(&h, out->buf + out->len);
+    int ret = 0;
+
+    out->len += (size_t)pos;
+    for (size_t i = 0; i < count; ++i) {
+        size_t f = i * LPC10_FILE_SYNC_FRAMES, n = frames - f < LPC10_FILE_SYNC_FRAMES ? frames - f : LPC10_FILE_SYNC_FRAMES;
+        size_t len = (size_t)stream_bytes(n, tight), sync;
+
+        if (out->len + LPC10_FILE_SYNC_BYTES + len > CLI_WRITE_BYTES && out_flush(out) < 0) {
+            ret = -1;
+            break;
+        }
+        syncs[i] = (struct lpc10_file_sync){(long long)f, (long long)pos};
+        sync = (size_t)lpc10_file_sync_write((long long)f, (int)n, st, out->buf + out->len);
+        memcpy(out->buf + out->len + sync, stream + stream_bytes(f, tight), len);
+        out->len += sync + len;
+        pos += (off_t)(sync + len);
+        lpc10_decode_s16(stream + stream_bytes(f, tight), (int)len, pcm, tight, st);
+    }
+    if (ret == 0) {
+        h.nframes = (long long)frames;
+        h.index = (long long)pos;
+        lpc10_file_header_write(&h, header);
+        ret = out_flush(out);
+    }
+    if (ret == 0)
+        ret = pwrite_all(out->fd, index, (size_t)lpc10_file_index_write(syncs, (int)count, index), pos);
+    if (ret == 0)
+        ret = pwrite_all(out->fd, header, sizeof(header), 0);
+    free(pcm);
+    free(st);
+    free(index);
+    free(syncs);
+    return ret;
+}
+
+/* Encodes the samples of one input into out in the LPC-10 file format, by way of a temporary file. */
+static int encode_file_format(const CliOptions* opts, const unsigned char* data, size_t size, CliOut* out) {
+    CliOut enc = {-1, out->buf, 0};
+    CliMap stream = {NULL, 0};
+    FILE* tmp = tmpfile();
+    int ret = -1;
+
+    if (!tmp)
+        return -1;
+    enc.fd = fileno(tmp);
+    ret = opts->chunked ? encode_chunked(opts, data, size, enc.fd) : encode_samples(opts, data, size, &enc);
+    if (ret == 0)
+        ret = out_flush(&enc);
+    if (ret == 0)
+        ret = map_fd("temporary file", enc.fd, &stream);
+    if (ret == 0)
+        ret = write_file_format(opts, stream.data, stream.size, out);
+    unmap_file(&stream);
+    fclose(tmp);
+    return ret;
+}
+
+static void wav_header(unsigned char* h, size_t data_bytes) {
+    memcpy(h, "RIFF", 4);
+    put_le32(h + 4, (uint32_t)(36 + data_bytes));
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_le32(h + 16, 16);
+    put_le32(h + 20, 1 | 1 << 16);  // PCM, mono
+    put_le32(h + 24, 8000);
+    put_le32(h + 28, 8000 * 2);
+    put_le32(h + 32, 2 | 16 << 16);  // 2 bytes per frame, 16 bits
+    memcpy(h + 36, "data", 4);
+    put_le32(h + 40, (uint32_t)data_bytes);
+}
+
+static int transcode_file(const CliOptions* opts, const char* input) {
+    CliOptions file_opts = *opts;
+    CliMap map;
+    CliOut out = {-1, NULL, 0};
+    CliSection* sections = NULL;
+    long nsections = -1;  // Decoding, the sync points of an LPC-10 file; -1 for a bare stream
+    struct lpc10_file_header h;
+    const unsigned char* data;
+    size_t size;
+    char* path;
+    int ret = -1;
+
+    if (map_file(input, &map) < 0)
+        return -1;
+    if (opts->decode || opts->rewrap) {
+        data = map.data;
+        size = map.size;
+        if (opts->decode && size > 0 && lpc10_file_header_read(&h, data, size > INT_MAX ? INT_MAX : (int)size) > 0) {
+            // The file says how it is packed
+            file_opts.tight = h.tight;
+            nsections = read_sections(input, data, size, h.tight, &sections);
+            if (nsections < 0) {
+                unmap_file(&map);
+                return -1;
+            }
+        }
+        path = output_path(opts, input, opts->rewrap ? ".lpc10" : opts->wav ? ".wav" : ".raw");
+        if (strcmp(path, input) == 0) {
+            fprintf(stderr, "%s: would be overwritten, give -o\n", input);
+            free(path);
+            free(sections);
+            unmap_file(&map);
+            return -1;
+        }
+    } else {
+        if (find_samples(input, &map, &data, &size) < 0) {
+            unmap_file(&map);
+            return -1;
+        }
+        path = output_path(opts, input, ".lpc10");
+    }
+    opts = &file_opts;
+
+    // Room for a batch on top of CLI_WRITE_BYTES, so a batch never has to be split
+    out.buf = check_alloc(malloc(CLI_WRITE_BYTES + CLI_BATCH_FRAMES * LPC10_SAMPLES_PER_FRAME * sizeof(INT16)));
+    out.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out.fd < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        goto done;
+    }
+    if (opts->decode && opts->wav) {
+        size_t frames = opts->tight ? size / LPC10_TIGHT_BYTES * LPC10_TIGHT_FRAMES : size / LPC10_BYTES_IN_COMPRESSED_FRAME;
+        size_t data_bytes;
+
+        if (nsections >= 0)
+            frames = nsections > 0 ? sections[nsections - 1].frame + sections[nsections - 1].nframes : 0;
+        data_bytes = frames * LPC10_SAMPLES_PER_FRAME * sizeof(INT16);
+        wav_header(out.buf, data_bytes > UINT32_MAX - 36 ? UINT32_MAX - 36 : data_bytes);
+        out.len = CLI_WAV_HEADER;
+    }
+    if (opts->decode && nsections >= 0 && opts->chunked) {
+        ret = decode_file_chunked(opts, sections, (size_t)nsections, out.fd, (off_t)out.len);
+    } else if (opts->decode) {
+        struct lpc10_decoder_state* st = check_alloc(create_lpc10_decoder_state());
+
+        if (nsections < 0 && opts->chunked)
+            ret = decode_chunked(opts, data, size, out.fd, (off_t)out.len);
+        else if (nsections < 0)
+            ret = decode_frames(opts, data, size, st, &out);
+        else {
+            // The decoder carries on from one sync point to the next; their states are only for seeking
+            ret = 0;
+            for (long i = 0; i < nsections && ret == 0; ++i)
+                ret = decode_frames(opts, sections[i].data, (size_t)stream_bytes(sections[i].nframes, opts->tight), st, &out);
+        }
+        free(st);
+    } else if (opts->rewrap) {
+        ret = write_file_format(opts, data, size, &out);
+    } else if (opts->file_format) {
+        ret = encode_file_format(opts, data, size, &out);
+    } else if (opts->chunked) {
+        ret = encode_chunked(opts, data, size, out.fd);
+    } else {
+        ret = encode_samples(opts, data, size, &out);
+    }
+    if (ret == 0)
+        ret = out_flush(&out);
+    if (ret < 0)
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    if (close(out.fd) < 0 && ret == 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        ret = -1;
+    }
+
+done:
+    free(out.buf);
+    free(path);
+    free(sections);
+    unmap_file(&map);
+    return ret;
+}
+
+static void* worker(void* arg) {
+    CliJobs* jobs = arg;
+    int i;
+
+    while ((i = atomic_fetch_add(&jobs->next, 1)) < jobs->count) {
+        if (transcode_file(jobs->opts, jobs->inputs[i]) < 0)
+            atomic_fetch_add(&jobs->failed, 1);
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    CliOptions opts = {0};
+    CliJobs jobs;
+    long njobs = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t* threads;
+    struct stat sb;
+    int opt;
+
+    opts.warmup = -1;
+    while ((opt = getopt(argc, argv, "dtwLCRpW:j:o:")) != -1) {
+        switch (opt) {
+            case 'd':
+                opts.decode = 1;
+                break;
+            case 't':
+                opts.tight = 1;
+                break;
+            case 'w':
+                opts.wav = 1;
+                break;
+            case 'L':
+                opts.low_delay = 1;
+                break;
+            case 'C':
+                opts.file_format = 1;
+                break;
+            case 'R':
+                opts.file_format = opts.rewrap = 1;
+                break;
+            case 'p':
+                opts.chunked = 1;
+                break;
+            case 'W':
+                opts.warmup = atoi(optarg) > 0 ? atoi(optarg) : 0;
+                break;
+            case 'j':
+                njobs = atol(optarg);
+                break;
+            case 'o':
+                opts.output = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-d] [-t] [-w] [-L] [-C] [-R] [-p] [-W frames] [-j jobs] [-o output] input...\n", argv[0]);
+                return 2;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "usage: %s [-d] [-t] [-w] [-L] [-C] [-R] [-p] [-W frames] [-j jobs] [-o output] input...\n", argv[0]);
+        return 2;
+    }
+    if (opts.output) {
+        opts.output_is_dir = stat(opts.output, &sb) == 0 && S_ISDIR(sb.st_mode);
+        if (!opts.output_is_dir && argc - optind > 1) {
+            fprintf(stderr, "%s: -o has to be a directory for several inputs\n", opts.output);
+            return 2;
+        }
+    }
+
+    jobs.opts = &opts;
+    jobs.inputs = argv + optind;
+    jobs.count = argc - optind;
+    atomic_init(&jobs.next, 0);
+    atomic_init(&jobs.failed, 0);
+    if (njobs < 1)
+        njobs = 1;
+    if (opts.warmup < 0)
+        opts.warmup = opts.decode ? LPC10_CHUNK_PREROLL : LPC10_CHUNK_WARMUP;
+    if (opts.chunked) {
+        // The threads go to the chunks of one file at a time
+        opts.threads = (int)njobs;
+        njobs = 1;
+    }
+    if (njobs > jobs.count)
+        njobs = jobs.count;
+
+    // The main thread is one of the workers
+    threads = check_alloc(malloc((size_t)njobs * sizeof(pthread_t)));
+    for (long i = 1; i < njobs; ++i) {
+        if (pthread_create(&threads[i], NULL, worker, &jobs) != 0) {
+            njobs = i;
+            break;
+        }
+    }
+    worker(&jobs);
+    for (long i = 1; i < njobs; ++i)
+        pthread_join(threads[i], NULL);
+    free(threads);
+
+    return atomic_load(&jobs.failed) > 0;
+}